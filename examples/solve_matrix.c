@@ -0,0 +1,50 @@
+/* Solves a small instance held in memory through the C API of libpfsp */
+
+#include "pfsp.h"
+#include <stdio.h>
+
+enum { JOBS = 6, MACHINES = 3 };
+
+int main(void) {
+    /* times[job * MACHINES + machine], borrowed by the problem */
+    static const int times[JOBS * MACHINES] = {
+        5, 9, 8,
+        9, 3, 10,
+        9, 4, 5,
+        4, 8, 8,
+        3, 5, 6,
+        10, 6, 3,
+    };
+    pfsp_problem* problem;
+    pfsp_options options;
+    pfsp_stats stats;
+    int permutation[JOBS];
+    int job;
+
+    if (pfsp_api_version() != PFSP_API_VERSION) {
+        fprintf(stderr, "Header and library versions differ\n");
+        return 1;
+    }
+    if (pfsp_problem_create(JOBS, MACHINES, times, PFSP_LAYOUT_JOB_MAJOR, &problem) != PFSP_OK) {
+        fprintf(stderr, "%s\n", pfsp_last_error());
+        return 1;
+    }
+
+    pfsp_options_init(&options);
+    options.seed = 42;
+    options.params = "iter=200,d=2";
+    if (pfsp_solve(problem, "ig", &options, permutation, &stats) != PFSP_OK) {
+        fprintf(stderr, "%s\n", pfsp_last_error());
+        pfsp_problem_destroy(problem);
+        return 1;
+    }
+
+    printf("Makespan: %d (lower bound %d)\nPermutation:", stats.makespan, stats.lower_bound);
+    for (job = 0; job < JOBS; ++job) {
+        printf(" %d", permutation[job] + 1);
+    }
+    printf("\nEvaluations: %lld in %.6f s\n", stats.evaluations, stats.time);
+
+    pfsp_problem_destroy(problem);
+    return 0;
+}
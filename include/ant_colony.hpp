@@ -1,11 +1,30 @@
 #pragma once
 
 #include "metaheuristic.hpp"
+#include "pheromone_matrix.hpp"
 #include <vector>
-#include <random>
 
 class AntColony : public Metaheuristic {
 public:
+    // What a pheromone trail rewards
+    enum class PheromoneModel {
+        JobSuccession,  // Job j directly after job i (n x n trails)
+        JobPosition     // Job j at a position range (buckets x n trails)
+    };
+    
+    // Storage and bounds of the pheromone trails
+    struct PheromoneOptions {
+        PheromoneModel model = PheromoneModel::JobSuccession;
+        bool singlePrecision = false;  // Store trails as float instead of double
+        double minPheromone = 0.0;     // MAX-MIN lower bound, 0 for none
+        double maxPheromone = 0.0;     // MAX-MIN upper bound, 0 for none
+        
+        // Cap in bytes on the trail and heuristic tables, 0 for none. The
+        // position model groups neighboring positions into fewer buckets to
+        // stay under it; the succession model cannot shrink and ignores it.
+        size_t memoryLimit = 0;
+    };
+    
     // Default constructor
     AntColony(const Problem& problem);
     
@@ -15,10 +34,23 @@ public:
     
     Solution solve() override;
     
+    void setPheromoneOptions(const PheromoneOptions& options) { pheromoneOptions = options; }
+    
+    // Bytes used by the trail and heuristic tables of the last run
+    size_t getPheromoneMemory() const;
+    
+    // Stop building an ant once a lower bound on its makespan exceeds the
+    // best ant of the current iteration (enabled by default). Abandoned ants
+    // deposit no pheromone.
+    void setEarlyAbandonment(bool enabled) { earlyAbandonment = enabled; }
+    long long getAbandonedAnts() const { return abandonedAnts; }
+    
 private:
     struct Ant {
         std::vector<int> permutation;
         int makespan;
+        bool abandoned;  // Stopped early, permutation is incomplete
+        Rng rng;         // Own stream, split from the solver seed
     };
     
     // Parameters
@@ -27,18 +59,43 @@ private:
     double evaporationRate;
     double alpha;  // Pheromone importance
     double beta;   // Heuristic importance
+    PheromoneOptions pheromoneOptions;
+    bool earlyAbandonment;
+    long long abandonedAnts;
     
     // Components
     void initializePheromones();
+    void initializeHeuristic();
     void constructSolutions();
     void updatePheromones();
     double calculateHeuristic(int i, int j) const;
+    int positionBucket(int position) const;
+    
+    template <typename T>
+    void constructSolutions(const PheromoneMatrix<T>& trails);
+    template <typename T>
+    void updatePheromones(PheromoneMatrix<T>& trails);
     
-    // Pheromone matrix
-    std::vector<std::vector<double>> pheromones;
+    // Pheromone matrix, in the precision selected by pheromoneOptions
+    PheromoneMatrix<double> pheromones;
+    PheromoneMatrix<float> pheromonesSingle;
     std::vector<Ant> ants;
     
-    // Random number generation
-    std::random_device rd;
-    std::mt19937 gen;
+    // Flat table of heuristic^beta with the same rows as the trails
+    // ([previous job * n + job] or [bucket * n + job]), fixed for a run so
+    // construction needs no pow() calls
+    std::vector<double> heuristicTable;
+    std::vector<int> jobTotals;  // Total processing time of each job
+    int positionBuckets;         // Rows of the position model
+    
+    // Construction buffers reused by every ant
+    std::vector<int> unvisited;
+    std::vector<double> cumulative;
+    
+    // Completion times of the partial schedule on every machine, maintained
+    // while the ant appends jobs, and the work still to be scheduled
+    std::vector<int> completionTimes;
+    std::vector<int> remainingWork;
+    std::vector<int> machineTotals;  // Total processing time on each machine
+    std::vector<int> minTails;       // Least time any job needs after each machine
 }; 
\ No newline at end of file
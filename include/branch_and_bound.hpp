@@ -0,0 +1,97 @@
+#pragma once
+
+#include "metaheuristic.hpp"
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+
+// Exact solver for small instances. Sequences are built forward, one job
+// appended per level, and depth-first search prunes every node whose lower
+// bound reaches the incumbent:
+// - LB1: on each machine, the current completion time plus the remaining
+//   work plus the shortest tail of a remaining job
+// - LB2: Johnson's rule with time lags on pairs of machines (adjacent
+//   pairs and every machine paired with the last), computed only when LB1
+//   does not prune
+// Every thread explores its own stack of open nodes and idle threads steal
+// the shallowest node of another thread, which holds the largest subtree.
+// If a node or time limit stops the search, the smallest bound among the
+// open nodes is kept, so the result still comes with a valid gap.
+class BranchAndBound : public Metaheuristic {
+public:
+    // Default constructor: all hardware threads, default node limit
+    BranchAndBound(const Problem& problem);
+
+    // maxNodes <= 0 means no node limit
+    BranchAndBound(const Problem& problem, int numThreads, long long maxNodes);
+
+    Solution solve() override;
+
+    // Starts from this solution instead of NEH when it is better
+    void setInitialSolution(const Solution& solution);
+
+    // Results of the last solve()
+    bool isOptimal() const { return optimal; }
+    int getLowerBound() const { return lowerBound; }
+    double getGap() const;
+    long long getNodes() const { return nodes.load(); }
+
+private:
+    // Open subproblem: the first depth jobs of permutation are scheduled,
+    // front holds their completion times on every machine
+    struct Node {
+        std::vector<int> permutation;
+        std::vector<int> front;
+        int depth;
+        int bound;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Node> stack;  // Own work at the back, stolen from the front
+    };
+
+    // Per-thread scratch space for bounding
+    struct Scratch {
+        std::vector<char> scheduled;
+        std::vector<int> remaining;   // Work left per machine
+        std::vector<int> minTail;     // Shortest and second shortest tails
+        std::vector<int> secondTail;  // per machine, with the job holding
+        std::vector<int> minTailJob;  // the shortest one
+        std::vector<int> childFront;
+        std::vector<Node> children;
+    };
+
+    void precompute();
+    void work(int id);
+    bool takeNode(int id, Node& node);
+    void expand(int id, Node& node, Scratch& scratch);
+    int childBound(const Node& parent, int job, Scratch& scratch, int upperBound) const;
+    void recordSchedule(const std::vector<int>& permutation, int makespan);
+    bool limitReached();
+
+    // Parameters
+    int numThreads;
+    long long maxNodes;
+
+    // Instance data in the layout the bounds need
+    std::vector<int> tails;                   // [job * m + machine]: work after that machine
+    std::vector<std::pair<int, int>> pairs;   // Machine pairs used by LB2
+    std::vector<std::vector<int>> johnsonOrders;  // Job order for each pair
+    std::vector<std::vector<int>> lags;       // [pair][job]: work between the two machines
+
+    // Shared search state
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<int> upperBound;
+    std::atomic<long long> pending;  // Open nodes plus nodes being expanded
+    std::atomic<long long> nodes;
+    std::atomic<bool> stopSearch;
+    std::mutex incumbentMutex;
+
+    bool hasInitialSolution;
+    Solution initialSolution;
+    bool optimal;
+    int lowerBound;
+};
@@ -7,9 +7,11 @@ public:
     Constructive(const Problem& problem);
     Solution solve() override;
     
+    // NEH computed from scratch, bypassing the per-problem cache
+    std::vector<int> nehAlgorithm();
+    
 private:
     // Different constructive methods
-    std::vector<int> nehAlgorithm();
     std::vector<int> randomPermutation();
     std::vector<int> shortestProcessingTime();
 }; 
\ No newline at end of file
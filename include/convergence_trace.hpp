@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Preallocated ring buffer of incumbent improvements (elapsed search time,
+// evaluations, iteration, makespan), filled by Metaheuristic::updateBest.
+// Recording never allocates or locks: one writer at a time fills the next
+// slot under a per-slot sequence number, and snapshot() can run
+// concurrently, skipping slots that are being overwritten. When the buffer
+// is full, the oldest points are dropped.
+class ConvergenceTrace {
+public:
+    struct Point {
+        double time;          // Seconds since the start of the search
+        long long evaluations;
+        long long iteration;  // Iteration, generation or sweep of the solver
+        int makespan;
+    };
+
+    explicit ConvergenceTrace(size_t capacity);
+
+    void record(const Point& point) {
+        uint64_t index = head.load(std::memory_order_relaxed);
+        Slot& slot = slots[index % capacity];
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.time.store(point.time, std::memory_order_relaxed);
+        slot.evaluations.store(point.evaluations, std::memory_order_relaxed);
+        slot.iteration.store(point.iteration, std::memory_order_relaxed);
+        slot.makespan.store(point.makespan, std::memory_order_relaxed);
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+        head.store(index + 1, std::memory_order_release);
+    }
+
+    // Points still held, oldest first
+    std::vector<Point> snapshot() const;
+    void clear() { head.store(0, std::memory_order_relaxed); }
+
+    size_t getCapacity() const { return capacity; }
+    uint64_t getRecorded() const { return head.load(std::memory_order_acquire); }
+    uint64_t getDropped() const;
+
+    // One "label,time,evaluations,iteration,makespan" line per point; the
+    // header is written separately so several traces can share a file
+    static void writeCsvHeader(std::ostream& out);
+    void writeCsv(std::ostream& out, const std::string& label) const;
+
+    // {"solver": label, "dropped": n, "points": [[time, evaluations, iteration, makespan], ...]}
+    void writeJson(std::ostream& out, const std::string& label) const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence{0};  // 2k + 1 while point k is written, 2k + 2 once done
+        std::atomic<double> time{0.0};
+        std::atomic<long long> evaluations{0};
+        std::atomic<long long> iteration{0};
+        std::atomic<int> makespan{0};
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t capacity;
+    std::atomic<uint64_t> head;  // Points recorded so far
+};
@@ -2,7 +2,6 @@
 
 #include "metaheuristic.hpp"
 #include <vector>
-#include <random>
 
 class GeneticAlgorithm : public Metaheuristic {
 public:
@@ -14,28 +13,49 @@ public:
     
     Solution solve() override;
     
+    // Elitist steady-state replacement: offspring replace the worst
+    // individual when better and not already in the population, instead of
+    // replacing the whole population
+    void setSteadyState(bool enabled) { steadyState = enabled; }
+    
 private:
-    // Components
-    struct Individual {
-        std::vector<int> permutation;
-        int makespan;
+    // Population stored as one contiguous block of populationSize * n genes.
+    // Two arenas alternate: selection/crossover read one and write the other.
+    struct Population {
+        std::vector<int> genes;
+        std::vector<int> makespans;
+        std::vector<uint64_t> hashes;  // Valid for individuals that are not dirty
+        std::vector<char> dirty;  // Genes changed since the last evaluation
+        
+        int* individual(int index, int n) { return &genes[static_cast<size_t>(index) * n]; }
+        const int* individual(int index, int n) const { return &genes[static_cast<size_t>(index) * n]; }
     };
     
+    // Components
     void initializePopulation();
     void evaluatePopulation();
     void selection();
     void crossover();
     void mutation();
+    void steadyStateGeneration();
+    
+    int tournament();
+    void orderCrossover(const int* parent1, const int* parent2, int* child, int start, int length);
+    bool mutate(int* genes);
+    void evaluate(Population& population, int index);
+    bool contains(const Population& population, uint64_t hash) const;
     
     // Parameters
     int populationSize;
     int maxGenerations;
     double mutationRate;
+    bool steadyState;
     
-    // Population
-    std::vector<Individual> population;
-    
-    // Random number generation
-    std::random_device rd;
-    std::mt19937 gen;
-}; 
\ No newline at end of file
+    // Population arenas, parents selected for the next generation (indices
+    // into the current arena) and a stamp array used as a reusable bitset
+    Population arenas[2];
+    int current;
+    std::vector<int> parents;
+    std::vector<unsigned> usedStamp;
+    unsigned stamp;
+};
@@ -10,6 +10,7 @@
 #include "tabu_search.hpp"
 #include "genetic_algorithm.hpp"
 #include "ant_colony.hpp"
+#include "iterated_greedy.hpp"
 #include <string>
 #include <vector>
 #include <map>
@@ -23,6 +24,9 @@ struct GeneticAlgorithmParams {
     std::vector<int> populationSizes = {20, 50, 100};
     std::vector<int> maxGenerations = {50, 100, 200};
     std::vector<double> mutationRates = {0.05, 0.1, 0.2};
+    
+    // Applied to every run, not a grid dimension
+    bool steadyState = false;
 
     // Default constructor uses default values above
     GeneticAlgorithmParams() = default;
@@ -40,6 +44,9 @@ struct AntColonyParams {
     std::vector<double> evaporationRates = {0.05, 0.1, 0.2};
     std::vector<double> alphaValues = {0.5, 1.0, 1.5};
     std::vector<double> betaValues = {1.0, 2.0, 3.0};
+    
+    // Applied to every run, not a grid dimension
+    AntColony::PheromoneOptions pheromoneOptions;
 
     // Default constructor uses default values above
     AntColonyParams() = default;
@@ -96,6 +103,9 @@ struct SimulatedAnnealingParams {
 struct TabuSearchParams {
     std::vector<int> maxIterations = {500, 1000, 2000};
     std::vector<int> tabuListSizes = {5, 10, 20};
+    
+    // Applied to every run, not a grid dimension
+    TabuSearch::Neighborhood neighborhood = TabuSearch::Neighborhood::CriticalBlocks;
 
     // Default constructor uses default values above
     TabuSearchParams() = default;
@@ -106,10 +116,32 @@ struct TabuSearchParams {
         : maxIterations(iterations), tabuListSizes(tabuSizes) {}
 };
 
+struct IteratedGreedyParams {
+    std::vector<int> maxIterations = {200, 500, 1000};
+    std::vector<int> destructionSizes = {2, 4, 6};
+    std::vector<double> temperatureFactors = {0.2, 0.4, 0.6};
+
+    // Default constructor uses default values above
+    IteratedGreedyParams() = default;
+    
+    // Custom constructor for specifying parameter sets
+    IteratedGreedyParams(const std::vector<int>& iterations,
+                         const std::vector<int>& destructions,
+                         const std::vector<double>& temperatures)
+        : maxIterations(iterations), destructionSizes(destructions), temperatureFactors(temperatures) {}
+};
+
 class GridSearch {
 public:
     GridSearch(const Problem& problem);
     
+    // Stopping criteria applied to every run in the grid
+    void setTermination(const Termination& criteria) { termination = criteria; }
+    void setTranspositionTable(std::shared_ptr<TranspositionTable> table) { transpositionTable = std::move(table); }
+    
+    // Every run in the grid starts from this seed
+    void setSeed(uint64_t value) { seed = value; }
+    
     // Run grid search for a specific algorithm
     void runGeneticAlgorithm(const GeneticAlgorithmParams& params);
     void runAntColony(const AntColonyParams& params);
@@ -117,6 +149,7 @@ public:
     void runLocalSearch(const LocalSearchParams& params);
     void runSimulatedAnnealing(const SimulatedAnnealingParams& params);
     void runTabuSearch(const TabuSearchParams& params);
+    void runIteratedGreedy(const IteratedGreedyParams& params);
     
     // Run grid search for all algorithms with default parameter ranges
     void runAll();
@@ -131,6 +164,9 @@ private:
     Solution bestSolution;
     std::string bestAlgorithm;
     std::string bestParameters;
+    Termination termination;
+    std::shared_ptr<TranspositionTable> transpositionTable;
+    uint64_t seed;
     
     // Helper method to update the best solution
     void updateBestSolution(const std::string& algorithm, const std::string& params, const Solution& solution);
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "problem.hpp"
+#include "objective.hpp"
+#include <vector>
+#include <deque>
+#include "random.hpp"
+#include <functional>
+
+// Insertion neighborhood with Taillard's acceleration. For a sequence of k
+// jobs, the makespans of inserting one more job at all k+1 positions are
+// obtained together in O(k*m) from the heads (earliest completion times of
+// the prefix) and tails (latest start times of the suffix), instead of
+// O(k^2*m) with one full evaluation per position. Other objectives use the
+// insertion kernels of their policy (include/objective.hpp).
+class InsertionSearch {
+public:
+    // Receives the number of evaluations spent since the last call and
+    // returns true if the search should stop
+    using Progress = std::function<bool(long long evaluations)>;
+
+    InsertionSearch(const Problem& problem);
+
+    // Best position to insert job into sequence (which must not contain it).
+    // Ties keep the earliest position. Returns the resulting objective value.
+    int bestInsertion(const std::vector<int>& sequence, int job, int& bestPosition);
+    
+    // Objective value of inserting job at every position 0..k of sequence
+    void insertionValues(const std::vector<int>& sequence, int job, std::vector<int>& values);
+
+    // One first-improvement pass in the style of Ruiz and Stützle: every job
+    // is removed in random order and reinserted at its best position, and the
+    // move is kept if the makespan decreases. Returns true if it improved.
+    bool sweep(std::vector<int>& permutation, int& makespan, Rng& rng,
+               const Progress& progress = nullptr);
+
+    // Repeats sweeps until a local optimum for the insertion neighborhood
+    bool descend(std::vector<int>& permutation, int& makespan, Rng& rng,
+                 const Progress& progress = nullptr);
+    
+    // Descent with don't-look bits: only the given jobs are tried at first,
+    // and a job is tried again only after an improving move has changed its
+    // neighbors in the sequence. Suited to solutions that are already a
+    // local optimum except around a few disturbed jobs.
+    bool descendFrom(std::vector<int>& permutation, int& makespan, const std::vector<int>& jobs,
+                     const Progress& progress = nullptr);
+
+private:
+    const Problem& problem;
+
+    // Work buffers reused across calls
+    InsertionBuffers buffers;
+    std::vector<int> candidates;
+    std::vector<int> removed;
+    std::vector<int> order;
+    std::deque<int> pending;    // Jobs whose don't-look bit is off
+    std::vector<char> looking;
+    bool stopped;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "metaheuristic.hpp"
+#include "insertion_search.hpp"
+#include <vector>
+
+// Iterated Greedy (Ruiz and Stützle, 2007): remove d random jobs, reinsert
+// them one by one at their best position as in NEH, improve the result with
+// the insertion local search and accept it with a constant-temperature
+// simulated annealing criterion.
+class IteratedGreedy : public Metaheuristic {
+public:
+    // Default constructor
+    IteratedGreedy(const Problem& problem);
+    
+    // Parameterized constructor
+    IteratedGreedy(const Problem& problem, int maxIterations, int destructionSize, double temperatureFactor);
+    
+    Solution solve() override;
+    
+private:
+    // Components
+    void destruction(std::vector<int>& permutation, std::vector<int>& removedJobs);
+    int construction(std::vector<int>& permutation, const std::vector<int>& removedJobs);
+    bool acceptWorseSolution(int currentMakespan, int newMakespan);
+    
+    // Parameters
+    int maxIterations;
+    int destructionSize;
+    double temperatureFactor;
+    
+    // Constant temperature derived from the instance's processing times
+    double temperature;
+    
+    // Accelerated insertion moves
+    InsertionSearch insertion;
+};
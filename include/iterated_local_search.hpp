@@ -1,6 +1,9 @@
 #pragma once
 
 #include "metaheuristic.hpp"
+#include "insertion_search.hpp"
+#include <vector>
+#include <deque>
 
 class IteratedLocalSearch : public Metaheuristic {
 public:
@@ -8,16 +11,38 @@ public:
     IteratedLocalSearch(const Problem& problem);
     
     // Parameterized constructor
-    IteratedLocalSearch(const Problem& problem, int maxIterations, int perturbationStrength);
+    // useInsertion selects the accelerated insertion descent (default) or the
+    // best-improvement swap descent for the local search phase
+    IteratedLocalSearch(const Problem& problem, int maxIterations, int perturbationStrength,
+                        bool useInsertion = true);
     
     Solution solve() override;
     
+    // One iteration of solve(): perturb current, a local optimum, descend
+    // and keep the result only if it improves the best. Public so that it
+    // can be timed on its own once solve() has run.
+    void iterate(Solution& current);
+    
 private:
-    // Components
+    // Components. The perturbation records the jobs it disturbs and the
+    // local search starts from those only (don't-look bits).
     void perturbation(Solution& current);
     void localSearch(Solution& current);
+    void swapDescent(Solution& current);
+    void disturb(const std::vector<int>& permutation, int position);
     
     // Parameters
     int maxIterations;
     int perturbationStrength;
+    bool useInsertion;
+    
+    // Accelerated insertion moves
+    InsertionSearch insertion;
+    
+    // Work buffers
+    std::vector<int> working;
+    std::vector<int> positions;
+    std::vector<int> disturbed;
+    std::vector<char> looking;
+    std::deque<int> pending;
 }; 
\ No newline at end of file
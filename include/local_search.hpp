@@ -1,6 +1,7 @@
 #pragma once
 
 #include "metaheuristic.hpp"
+#include "insertion_search.hpp"
 
 class LocalSearch : public Metaheuristic {
 public:
@@ -20,4 +21,7 @@ private:
     
     // Parameters
     int maxIterations;
+    
+    // Accelerated insertion moves
+    InsertionSearch insertion;
 }; 
\ No newline at end of file
@@ -2,29 +2,94 @@
 
 #include <memory>
 #include <chrono>
+#include <ctime>
 #include "solution.hpp"
+#include "termination.hpp"
+#include "random.hpp"
+#include "convergence_trace.hpp"
 
 class Metaheuristic {
 public:
     Metaheuristic(const Problem& problem);
     virtual ~Metaheuristic() = default;
-    
+
     // Main solving method to be implemented by derived classes
     virtual Solution solve() = 0;
-    
+
     // Common methods for all metaheuristics
     Solution getBestSolution() const { return bestSolution; }
     double getExecutionTime() const { return executionTime; }
+    double getSetupTime() const { return setupTime; }
+    long long getEvaluations() const { return evaluations; }
+
+    // Stopping criteria and anytime reporting
+    void setTermination(const Termination& criteria) { termination = criteria; }
+    const Termination& getTermination() const { return termination; }
+    void setIncumbentCallback(IncumbentCallback callback) { onIncumbent = std::move(callback); }
+
+    // Optional cache of evaluated permutations, may be shared between solvers
+    void setTranspositionTable(std::shared_ptr<TranspositionTable> table) { transpositionTable = std::move(table); }
+    
+    // Optional record of every new incumbent; points accumulate over solve()
+    // calls until the trace is cleared
+    void setConvergenceTrace(std::shared_ptr<ConvergenceTrace> trace) { convergenceTrace = std::move(trace); }
     
+    // Runs with the same seed and parameters make the same random choices.
+    // Without a call, the seed comes from std::random_device.
+    void setSeed(uint64_t seed) { rng.reseed(seed); }
+    uint64_t getSeed() const { return rng.getSeed(); }
+    
+    // Warm start, e.g. a repaired schedule after the instance changed
+    // (include/replanning.hpp). Single-solution searches start from it
+    // instead of NEH, GA seeds its population with it and ACO its incumbent.
+    // An empty permutation restores the default start.
+    void setWarmStart(const std::vector<int>& permutation) { warmStart = permutation; }
+    bool hasWarmStart() const { return !warmStart.empty(); }
+
 protected:
     const Problem& problem;
     Solution bestSolution;
-    double executionTime;
-    
+    double executionTime;  // Search only
+    double setupTime;      // Building the initial solution, excluded from executionTime
+    long long evaluations;
+    Termination termination;
+    std::shared_ptr<TranspositionTable> transpositionTable;
+    std::shared_ptr<ConvergenceTrace> convergenceTrace;
+    Rng rng;
+    std::vector<int> warmStart;
+
+    // The warm start if one was set, NEH otherwise; sets setupTime
+    Solution startingSolution();
+
     // Helper methods
     void startTimer();
     void stopTimer();
-    
+    double elapsedTime() const;
+    double elapsedCpuTime() const;  // Process CPU time since startTimer()
+
+    // Cheap enough to call once per evaluated neighbor: the cancellation flag
+    // and evaluation count are tested on every call, the clocks periodically.
+    bool shouldStop();
+    // Also remembers the iteration for the convergence trace
+    bool iterationLimitReached(int iteration, int limit);
+    void countEvaluations(long long count = 1) { evaluations += count; }
+
+    // Replaces bestSolution if the candidate is better (or is the first one
+    // seen since startTimer) and notifies the incumbent callback. Reaching
+    // the problem's lower bound makes shouldStop() return true.
+    bool updateBest(const Solution& candidate);
+    bool improvesBest(int makespan) const {
+        return !hasIncumbent || makespan < bestSolution.getMakespan();
+    }
+
 private:
-    std::chrono::high_resolution_clock::time_point startTime;
-}; 
\ No newline at end of file
+    static constexpr int clockPollInterval = 32;
+
+    std::chrono::steady_clock::time_point startTime;
+    std::clock_t startCpuTime;
+    int pollCountdown;
+    long long currentIteration;  // Last value passed to iterationLimitReached
+    bool stopped;
+    bool hasIncumbent;
+    IncumbentCallback onIncumbent;
+};
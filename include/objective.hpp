@@ -0,0 +1,260 @@
+#pragma once
+
+#include "problem.hpp"
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Objective policies. Each one supplies the two kernels every solver runs
+// through Problem::evaluate and InsertionSearch:
+//   evaluate(problem, permutation[, cutoff])   full evaluation, the cutoff
+//       variant may stop early and return a lower bound >= cutoff
+//   insertionValues(problem, sequence, job, values, boundedByBest, buffers)
+//       objective of inserting job at every position 0..k of sequence
+// Policies are plain structs with static members, selected once per kernel
+// call by withObjective(); nothing inside a kernel is dispatched at run time.
+//
+// Values must fit in an int (sums are accumulated in 64 bits and clamped).
+
+// Work buffers of the insertion kernels, reused across calls
+struct InsertionBuffers {
+    std::vector<int> heads;                // (k+1) rows of m: completion times of the first r jobs
+    std::vector<int> tails;                // (k+1) rows of m: makespan only
+    std::vector<int> row;                  // Completion times of the job being placed
+    std::vector<int> lastCompletion;       // Completion of each job of the sequence on the last machine
+    std::vector<long long> prefixCost;     // Cost of the first r jobs
+};
+
+namespace objective_detail {
+
+inline int clampValue(long long value) {
+    return static_cast<int>(std::min<long long>(value, std::numeric_limits<int>::max()));
+}
+
+// heads row r: completion times on every machine after the first r jobs
+inline void computeHeads(const Problem& problem, const std::vector<int>& sequence, std::vector<int>& heads) {
+    const int m = problem.getNumMachines();
+    const int k = static_cast<int>(sequence.size());
+    heads.assign(static_cast<size_t>(k + 1) * m, 0);
+    for (int r = 1; r <= k; ++r) {
+        const int* times = problem.getJobTimes(sequence[r - 1]);
+        const int* prev = &heads[(r - 1) * m];
+        int* row = &heads[r * m];
+        row[0] = prev[0] + times[0];
+        for (int i = 1; i < m; ++i) {
+            row[i] = std::max(row[i - 1], prev[i]) + times[i];
+        }
+    }
+}
+
+} // namespace objective_detail
+
+// Makespan with Taillard's acceleration: heads and tails give all k+1
+// insertion makespans in O(k*m)
+struct MakespanObjective {
+    static constexpr Objective id = Objective::Makespan;
+
+    static int evaluate(const Problem& problem, const int* permutation) {
+        return problem.calculateMakespan(permutation);
+    }
+    static int evaluate(const Problem& problem, const int* permutation, int cutoff) {
+        return problem.calculateMakespan(permutation, cutoff);
+    }
+
+    static void insertionValues(const Problem& problem, const std::vector<int>& sequence, int job,
+                                std::vector<int>& values, bool /*boundedByBest*/, InsertionBuffers& buffers) {
+        const int m = problem.getNumMachines();
+        const int k = static_cast<int>(sequence.size());
+        objective_detail::computeHeads(problem, sequence, buffers.heads);
+
+        // tails row r: time from the start of job r on each machine to the
+        // end of the schedule made of jobs r..k-1
+        std::vector<int>& tails = buffers.tails;
+        tails.assign(static_cast<size_t>(k + 1) * m, 0);
+        for (int r = k - 1; r >= 0; --r) {
+            const int* times = problem.getJobTimes(sequence[r]);
+            const int* next = &tails[(r + 1) * m];
+            int* row = &tails[r * m];
+            row[m - 1] = next[m - 1] + times[m - 1];
+            for (int i = m - 2; i >= 0; --i) {
+                row[i] = std::max(row[i + 1], next[i]) + times[i];
+            }
+        }
+
+        // Completion times of the inserted job at each position, combined
+        // with the tails of the jobs that follow it
+        const int* jobTimes = problem.getJobTimes(job);
+        values.resize(k + 1);
+        for (int pos = 0; pos <= k; ++pos) {
+            const int* head = &buffers.heads[pos * m];
+            const int* tail = &tails[pos * m];
+            int makespan = 0;
+            int completion = 0;
+            for (int i = 0; i < m; ++i) {
+                completion = std::max(completion, head[i]) + jobTimes[i];
+                makespan = std::max(makespan, completion + tail[i]);
+            }
+            values[pos] = makespan;
+        }
+    }
+};
+
+// Objectives that add up a cost per job, given by Cost:
+//   cost(problem, job, completion)   cost of a job finishing at completion
+//                                    on the last machine
+//   shifted(problem, jobs, completions, count, delay, unshiftedCost)
+//                                    total cost of count jobs when each
+//                                    finishes delay later than completions,
+//                                    unshiftedCost being their cost at
+//                                    completions
+// The cost must not decrease as the completion grows.
+//
+// Insertion evaluates the heads once, then for every position places the
+// job and propagates the delay it causes through the jobs after it. As soon
+// as that delay is the same on every machine, every later job is delayed by
+// exactly that amount, so the rest of the sum follows from the known
+// completion times without touching the machines again (constant time for
+// flowtime, with prefix sums). Inserting a job never makes a later job
+// finish earlier, so the partial sum plus the cost of the remaining jobs at
+// their current completions bounds the value of a position. With
+// boundedByBest, a position is abandoned, its value set to that bound, as
+// soon as the bound reaches the best value of an earlier position; the
+// smallest value and its earliest position are still exact.
+template <typename Cost>
+struct SumObjective {
+    static constexpr Objective id = Cost::id;
+
+    static int evaluate(const Problem& problem, const int* permutation) {
+        return evaluate(problem, permutation, std::numeric_limits<int>::max());
+    }
+
+    // The cost of the scheduled jobs only grows, so it bounds the total
+    static int evaluate(const Problem& problem, const int* permutation, int cutoff) {
+        const int n = problem.getNumJobs();
+        const int m = problem.getNumMachines();
+        std::vector<int> completionTimes(m, 0);
+        long long total = 0;
+        for (int j = 0; j < n; ++j) {
+            const int* times = problem.getJobTimes(permutation[j]);
+            completionTimes[0] += times[0];
+            for (int i = 1; i < m; ++i) {
+                completionTimes[i] = std::max(completionTimes[i], completionTimes[i - 1]) + times[i];
+            }
+            total += Cost::cost(problem, permutation[j], completionTimes[m - 1]);
+            if (total >= cutoff) {
+                break;
+            }
+        }
+        return objective_detail::clampValue(total);
+    }
+
+    static void insertionValues(const Problem& problem, const std::vector<int>& sequence, int job,
+                                std::vector<int>& values, bool boundedByBest, InsertionBuffers& buffers) {
+        const int m = problem.getNumMachines();
+        const int k = static_cast<int>(sequence.size());
+        objective_detail::computeHeads(problem, sequence, buffers.heads);
+        const std::vector<int>& heads = buffers.heads;
+
+        std::vector<int>& last = buffers.lastCompletion;
+        std::vector<long long>& prefix = buffers.prefixCost;
+        last.resize(k);
+        prefix.resize(k + 1);
+        prefix[0] = 0;
+        for (int r = 0; r < k; ++r) {
+            last[r] = heads[(r + 1) * m + m - 1];
+            prefix[r + 1] = prefix[r] + Cost::cost(problem, sequence[r], last[r]);
+        }
+        // Cost of jobs r..k-1 unshifted: prefix[k] - prefix[r]
+
+        std::vector<int>& row = buffers.row;
+        row.resize(m);
+        const int* jobTimes = problem.getJobTimes(job);
+        long long best = std::numeric_limits<long long>::max();
+        values.resize(k + 1);
+        for (int pos = 0; pos <= k; ++pos) {
+            const int* head = &heads[pos * m];
+            row[0] = head[0] + jobTimes[0];
+            for (int i = 1; i < m; ++i) {
+                row[i] = std::max(row[i - 1], head[i]) + jobTimes[i];
+            }
+            long long total = prefix[pos] + Cost::cost(problem, job, row[m - 1]);
+
+            // Jobs pos..k-1 of the sequence now come one place later
+            for (int r = pos; r < k; ++r) {
+                if (boundedByBest && total + prefix[k] - prefix[r] >= best) {
+                    total += prefix[k] - prefix[r];
+                    break;
+                }
+                const int* times = problem.getJobTimes(sequence[r]);
+                const int* original = &heads[(r + 1) * m];
+                row[0] += times[0];
+                int delay = row[0] - original[0];
+                bool uniform = true;
+                for (int i = 1; i < m; ++i) {
+                    row[i] = std::max(row[i - 1], row[i]) + times[i];
+                    uniform &= row[i] - original[i] == delay;
+                }
+                total += Cost::cost(problem, sequence[r], row[m - 1]);
+                if (uniform) {
+                    total += Cost::shifted(problem, &sequence[r + 1], &last[r + 1], k - r - 1, delay,
+                                           prefix[k] - prefix[r + 1]);
+                    break;
+                }
+            }
+            values[pos] = objective_detail::clampValue(total);
+            best = std::min(best, total);
+        }
+    }
+};
+
+struct FlowtimeCost {
+    static constexpr Objective id = Objective::Flowtime;
+
+    static long long cost(const Problem& /*problem*/, int /*job*/, int completion) { return completion; }
+
+    static long long shifted(const Problem& /*problem*/, const int* /*jobs*/, const int* /*completions*/,
+                             int count, int delay, long long unshiftedCost) {
+        return unshiftedCost + static_cast<long long>(delay) * count;
+    }
+};
+
+struct TardinessCost {
+    static constexpr Objective id = Objective::Tardiness;
+
+    static long long cost(const Problem& problem, int job, int completion) {
+        return std::max(0, completion - problem.getDueDate(job));
+    }
+
+    static long long shifted(const Problem& problem, const int* jobs, const int* completions,
+                             int count, int delay, long long /*unshiftedCost*/) {
+        long long total = 0;
+        for (int t = 0; t < count; ++t) {
+            total += std::max(0, completions[t] + delay - problem.getDueDate(jobs[t]));
+        }
+        return total;
+    }
+};
+
+using FlowtimeObjective = SumObjective<FlowtimeCost>;
+using TardinessObjective = SumObjective<TardinessCost>;
+
+// Calls fn with the policy of the objective, e.g.
+//   withObjective(problem.getObjective(), [&](auto policy) { return decltype(policy)::evaluate(problem, p); });
+template <typename Fn>
+decltype(auto) withObjective(Objective objective, Fn&& fn) {
+    switch (objective) {
+        case Objective::Flowtime:
+            return fn(FlowtimeObjective{});
+        case Objective::Tardiness:
+            return fn(TardinessObjective{});
+        case Objective::Makespan:
+        default:
+            return fn(MakespanObjective{});
+    }
+}
+
+// "makespan", "flowtime" or "tardiness"
+const char* objectiveName(Objective objective);
+// Inverse of objectiveName; throws std::invalid_argument for other names
+Objective parseObjective(const std::string& name);
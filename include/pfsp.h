@@ -0,0 +1,110 @@
+#ifndef PFSP_H
+#define PFSP_H
+
+/*
+ * C interface to libpfsp, for embedding the solvers in other programs
+ * without going through the pfsp executable. Every function returns a
+ * status code; on failure pfsp_last_error() describes the problem. No
+ * function throws or aborts.
+ *
+ *   pfsp_problem* problem;
+ *   pfsp_problem_create(jobs, machines, times, PFSP_LAYOUT_JOB_MAJOR, &problem);
+ *   pfsp_options options;
+ *   pfsp_options_init(&options);
+ *   options.time_limit = 0.5;
+ *   options.params = "iter=1000000,d=4";
+ *   pfsp_solve(problem, "ig", &options, permutation, &stats);
+ *   pfsp_problem_destroy(problem);
+ *
+ * A problem may be solved from several threads at once.
+ */
+
+#include <stdint.h>
+
+#if defined(_WIN32) && defined(PFSP_SHARED)
+#  ifdef PFSP_BUILDING
+#    define PFSP_API __declspec(dllexport)
+#  else
+#    define PFSP_API __declspec(dllimport)
+#  endif
+#elif defined(__GNUC__)
+#  define PFSP_API __attribute__((visibility("default")))
+#else
+#  define PFSP_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PFSP_API_VERSION 1
+
+typedef struct pfsp_problem pfsp_problem;
+
+typedef enum {
+    PFSP_OK = 0,
+    PFSP_INVALID_ARGUMENT = 1,  /* Bad size, time, solver parameter or null pointer */
+    PFSP_UNKNOWN_SOLVER = 2,
+    PFSP_INTERNAL = 3           /* Unexpected failure, e.g. out of memory */
+} pfsp_status;
+
+typedef enum {
+    /* times[job * machines + machine]: borrowed without copying, the
+       buffer must stay valid and unchanged until pfsp_problem_destroy */
+    PFSP_LAYOUT_JOB_MAJOR = 0,
+    /* times[machine * jobs + job], as in Taillard's files: copied once */
+    PFSP_LAYOUT_MACHINE_MAJOR = 1
+} pfsp_layout;
+
+typedef struct {
+    double time_limit;             /* Wall-clock seconds, 0 for none */
+    long long max_evaluations;     /* 0 for none */
+    uint64_t seed;                 /* 0 draws a random seed, reported in pfsp_stats */
+    int ignore_iteration_limits;   /* Non-zero: only the budget above stops the search */
+    const char* params;            /* "key=value,..." as for pfsp --help, may be NULL */
+} pfsp_options;
+
+typedef struct {
+    int makespan;
+    int lower_bound;
+    double time;                   /* Search seconds */
+    double setup_time;             /* Seconds spent on the initial solution */
+    long long evaluations;
+    uint64_t seed;                 /* Seed actually used */
+} pfsp_stats;
+
+/* PFSP_API_VERSION of the library, to detect a mismatched header */
+PFSP_API int pfsp_api_version(void);
+
+/* Message of the last failed call on this thread, "" if none */
+PFSP_API const char* pfsp_last_error(void);
+
+PFSP_API pfsp_status pfsp_problem_create(int jobs, int machines, const int* times, pfsp_layout layout,
+                                         pfsp_problem** out);
+/* Instance file in the format read by the pfsp executable */
+PFSP_API pfsp_status pfsp_problem_load(const char* filename, pfsp_problem** out);
+PFSP_API void pfsp_problem_destroy(pfsp_problem* problem);
+
+PFSP_API int pfsp_problem_jobs(const pfsp_problem* problem);
+PFSP_API int pfsp_problem_machines(const pfsp_problem* problem);
+PFSP_API int pfsp_problem_lower_bound(const pfsp_problem* problem);
+
+/* No budget, random seed, iteration limits honored, no parameters */
+PFSP_API void pfsp_options_init(pfsp_options* options);
+
+/*
+ * Runs a solver ("neh", "ls", "ils", "sa", "ts", "ga", "aco", "ig", "bnb")
+ * and writes the best permutation (jobs entries, 0-based) to permutation.
+ * options and stats may be NULL.
+ */
+PFSP_API pfsp_status pfsp_solve(const pfsp_problem* problem, const char* solver, const pfsp_options* options,
+                                int* permutation, pfsp_stats* stats);
+
+/* Makespan of a permutation of 0..jobs-1 */
+PFSP_API pfsp_status pfsp_evaluate(const pfsp_problem* problem, const int* permutation, int* makespan);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
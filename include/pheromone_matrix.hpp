@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+// Pheromone trails with lazy evaporation. Evaporation only shrinks a global
+// scale factor, so trail(i, j) = scale * raw[i][j]; deposits divide by the
+// current scale and touch just the entries they reinforce. The raw values are
+// folded back into the scale when it becomes too small to be represented
+// accurately.
+//
+// raw^alpha is cached next to every entry. Because x^alpha is monotonic,
+// max(scale * raw, min)^alpha == max(scale^alpha * raw^alpha, min^alpha), so
+// the weight of an edge never needs pow() during construction, even with
+// MAX-MIN bounds.
+template <typename T>
+class PheromoneMatrix {
+public:
+    // maxValue <= 0 means no upper bound
+    void initialize(int rows, int columns, double initialValue, double alpha,
+                    double minValue = 0.0, double maxValue = 0.0) {
+        this->rows = rows;
+        this->columns = columns;
+        this->alpha = alpha;
+        this->minValue = minValue;
+        this->maxValue = maxValue > 0.0 ? maxValue : std::numeric_limits<double>::infinity();
+        raw.assign(static_cast<size_t>(rows) * columns, static_cast<T>(initialValue));
+        rawPow.assign(raw.size(), static_cast<T>(std::pow(initialValue, alpha)));
+        scale = 1.0;
+        scalePow = 1.0;
+        minPow = minValue > 0.0 ? std::pow(minValue, alpha) : 0.0;
+    }
+
+    // O(1): trails decay through the global scale only
+    void evaporate(double rate) {
+        scale *= (1.0 - rate);
+        if (scale < renormalizeThreshold) {
+            renormalize();
+        }
+        scalePow = std::pow(scale, alpha);
+    }
+
+    void deposit(int i, int j, double amount) {
+        size_t index = static_cast<size_t>(i) * columns + j;
+        // Reinforce the trail as get() sees it, floored at the lower bound
+        double value = std::min(std::max(scale * raw[index], minValue) + amount, maxValue);
+        raw[index] = static_cast<T>(value / scale);
+        rawPow[index] = static_cast<T>(std::pow(static_cast<double>(raw[index]), alpha));
+    }
+
+    // Effective trail value, bounds applied
+    double get(int i, int j) const {
+        return std::max(scale * raw[static_cast<size_t>(i) * columns + j], minValue);
+    }
+
+    // trail(i, j)^alpha for every j is max(getScalePow() * row[j], getMinPow())
+    const T* powRow(int i) const { return &rawPow[static_cast<size_t>(i) * columns]; }
+    double getScalePow() const { return scalePow; }
+    double getMinPow() const { return minPow; }
+
+    size_t memoryBytes() const { return (raw.size() + rawPow.size()) * sizeof(T); }
+
+private:
+    // Below this scale, raw values grow large enough to lose precision
+    static constexpr double renormalizeThreshold = sizeof(T) < sizeof(double) ? 1e-6 : 1e-60;
+
+    void renormalize() {
+        for (size_t k = 0; k < raw.size(); ++k) {
+            raw[k] = static_cast<T>(scale * raw[k]);
+            rawPow[k] = static_cast<T>(std::pow(static_cast<double>(raw[k]), alpha));
+        }
+        scale = 1.0;
+    }
+
+    int rows = 0;
+    int columns = 0;
+    double alpha = 1.0;
+    double minValue = 0.0;
+    double maxValue = 0.0;
+    double scale = 1.0;
+    double scalePow = 1.0;
+    double minPow = 0.0;
+    std::vector<T> raw;
+    std::vector<T> rawPow;
+};
@@ -4,23 +4,106 @@
 #include <string>
 #include <fstream>
 #include <stdexcept>
+#include <map>
+#include <mutex>
+#include <functional>
+
+// What the solvers minimize (include/objective.hpp)
+enum class Objective {
+    Makespan,   // Completion time of the last job
+    Flowtime,   // Sum of the completion times of all jobs
+    Tardiness   // Sum of max(0, completion - due date), needs due dates
+};
 
 class Problem {
 public:
     Problem(const std::string& filename);
     
+    // Instance given directly as processing times [machine][job], copied
+    Problem(const std::vector<std::vector<int>>& processingTimes);
+    
+    // Borrows times stored job by job (times[job * numMachines + machine])
+    // without copying them; the buffer must outlive the problem
+    Problem(int numJobs, int numMachines, const int* jobMajorTimes);
+    
     // Getters
     int getNumMachines() const { return numMachines; }
     int getNumJobs() const { return numJobs; }
-    const std::vector<std::vector<int>>& getProcessingTimes() const { return processingTimes; }
+    int getProcessingTime(int machine, int job) const { return jobMajorTimes[job * numMachines + machine]; }
+    
+    // Objective of evaluate(), Solution::getMakespan() and every solver;
+    // the makespan unless changed. Set it before solving: changing it
+    // clears the cached permutations. Tardiness needs the due dates first.
+    void setObjective(Objective newObjective);
+    Objective getObjective() const { return objective; }
+    void setDueDates(const std::vector<int>& dates);
+    int getDueDate(int job) const { return dueDates[job]; }
+    
+    // Lower bound on the optimal objective value. For the makespan, the
+    // best of Taillard's machine-based and job-based bounds and any bound
+    // given in the file.
+    int getLowerBound() const { return objective == Objective::Makespan ? lowerBound : objectiveLowerBound; }
+    
+    // Best known makespan from the instance file, 0 if none was given
+    int getKnownUpperBound() const { return knownUpperBound; }
+    
+    // (value - lower bound) / lower bound
+    double relativeGap(int makespan) const;
     
-    // Calculate makespan for a given permutation
+    // Processing times of one job on machines 0..m-1, stored contiguously
+    const int* getJobTimes(int job) const { return &jobMajorTimes[job * numMachines]; }
+    
+    // Objective value of a permutation. Dispatches once to the kernels of
+    // the objective's policy; with the makespan objective these are the
+    // calculateMakespan variants below.
+    int evaluate(const std::vector<int>& permutation) const;
+    int evaluate(const int* permutation) const;
+    // May stop early and return a lower bound >= cutoff
+    int evaluate(const int* permutation, int cutoff) const;
+    
+    // Calculate makespan for a given permutation, whatever the objective
     int calculateMakespan(const std::vector<int>& permutation) const;
     
+    // Same, for numJobs jobs stored contiguously (no size check)
+    int calculateMakespan(const int* permutation) const;
+    
+    // Early-abort variant: the result is exact if it is below cutoff.
+    // Otherwise evaluation may stop as soon as the partial schedule proves
+    // the makespan is at least cutoff, and that lower bound is returned.
+    int calculateMakespan(const int* permutation, int cutoff) const;
+    
+    // Critical path of the schedule split into blocks: maximal runs of
+    // consecutive positions [first, last] processed on the same machine
+    // along the path, in sequence order. Returns the makespan.
+    struct Block {
+        int first;
+        int last;
+        int machine;
+    };
+    int criticalBlocks(const std::vector<int>& permutation, std::vector<Block>& blocks) const;
+    
+    // Thread-safe memo for permutations that depend only on this instance
+    // (e.g. constructive heuristics). compute runs at most once per key and
+    // must not request another cached permutation itself.
+    const std::vector<int>& getCachedPermutation(const std::string& key,
+                                                 const std::function<std::vector<int>()>& compute) const;
+    
 private:
     int numMachines;
     int numJobs;
-    std::vector<std::vector<int>> processingTimes; // [machine][job]
+    std::vector<int> ownedTimes;                   // Empty for borrowed times
+    const int* jobMajorTimes;                      // [job * numMachines + machine]
+    int lastMachineWork;                           // Total processing time on the last machine
+    int lowerBound;                                // On the makespan
+    int knownUpperBound;
+    Objective objective;
+    std::vector<int> dueDates;
+    int objectiveLowerBound;                       // On flowtime or tardiness
+    
+    mutable std::mutex cacheMutex;
+    mutable std::map<std::string, std::vector<int>> permutationCache;
     
     void loadFromFile(const std::string& filename);
+    void initialize();
+    void computeLowerBound();
 }; 
\ No newline at end of file
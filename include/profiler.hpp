@@ -0,0 +1,106 @@
+#pragma once
+
+// Scoped phase profiling, compiled in only when PFSP_PROFILE is defined
+// (cmake -DPFSP_PROFILE=ON). Without it the macros expand to nothing and
+// profiler.cpp is empty.
+//
+//   PFSP_PROFILE_SCOPE("GeneticAlgorithm::crossover");  // times the enclosing scope
+//   PFSP_PROFILE_COUNT("TabuSearch::moves", n);           // adds n to a counter
+//   PFSP_PROFILE_REPORT(std::cout);                       // prints the totals and resets them
+//
+// Times are inclusive (a phase includes the phases it calls) and summed over
+// all threads. Every thread accumulates into its own table, so timing a
+// scope costs two clock reads and two uncontended stores.
+
+#ifdef PFSP_PROFILE
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#else
+#include <chrono>
+#endif
+
+class Profiler {
+public:
+    static constexpr int maxSites = 256;
+
+    // Index of a named phase or counter, registered once per call site
+    static int registerSite(const char* name, bool counter);
+
+    // Time stamp counter where available, steady clock nanoseconds otherwise
+    static uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    static void add(int site, uint64_t ticks, uint64_t calls = 1) {
+        Totals& totals = local().sites[site];
+        totals.ticks.store(totals.ticks.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+        totals.calls.store(totals.calls.load(std::memory_order_relaxed) + calls, std::memory_order_relaxed);
+    }
+
+    // Per-phase breakdown since the last report. Meant to be called while
+    // no solver is running; a concurrent update may be lost by the reset.
+    static void report(std::ostream& out);
+
+private:
+    // Written only by the owning thread, read by report()
+    struct Totals {
+        std::atomic<uint64_t> ticks{0};
+        std::atomic<uint64_t> calls{0};
+    };
+
+    struct ThreadTotals {
+        Totals sites[maxSites];
+        ThreadTotals();
+        ~ThreadTotals();  // Hands the totals of a finished thread over to report()
+    };
+
+    static ThreadTotals& local() {
+        thread_local ThreadTotals totals;
+        return totals;
+    }
+};
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(int site) : site(site), start(Profiler::now()) {}
+    ~ScopedTimer() { Profiler::add(site, Profiler::now() - start); }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    int site;
+    uint64_t start;
+};
+
+#define PFSP_PROFILE_CONCAT_(a, b) a##b
+#define PFSP_PROFILE_CONCAT(a, b) PFSP_PROFILE_CONCAT_(a, b)
+#define PFSP_PROFILE_SCOPE(name) \
+    static const int PFSP_PROFILE_CONCAT(profileSite, __LINE__) = Profiler::registerSite(name, false); \
+    ScopedTimer PFSP_PROFILE_CONCAT(profileTimer, __LINE__)(PFSP_PROFILE_CONCAT(profileSite, __LINE__))
+#define PFSP_PROFILE_COUNT(name, amount) \
+    do { \
+        static const int profileSite = Profiler::registerSite(name, true); \
+        Profiler::add(profileSite, 0, static_cast<uint64_t>(amount)); \
+    } while (0)
+#define PFSP_PROFILE_REPORT(out) Profiler::report(out)
+
+#else
+
+#define PFSP_PROFILE_SCOPE(name) ((void)0)
+#define PFSP_PROFILE_COUNT(name, amount) ((void)0)
+#define PFSP_PROFILE_REPORT(out) ((void)0)
+
+#endif
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <random>
+
+// xoshiro256** generator (Blackman and Vigna): 32 bytes of state, a few
+// cycles per number, and usable wherever the standard library expects a
+// UniformRandomBitGenerator (std::shuffle, distributions).
+//
+// Runs are reproducible from the seed alone. split() derives independent
+// streams for threads, ants or islands from the seed and a stream index,
+// so a stream does not depend on how much any other stream has drawn.
+class Rng {
+public:
+    using result_type = uint64_t;
+
+    explicit Rng(uint64_t seed = 0) { reseed(seed); }
+
+    // Non-deterministic seed for runs where none was requested
+    static uint64_t randomSeed() {
+        std::random_device device;
+        return (static_cast<uint64_t>(device()) << 32) ^ device();
+    }
+
+    void reseed(uint64_t newSeed) {
+        seed = newSeed;
+        uint64_t x = newSeed;
+        for (auto& word : state) {
+            word = splitMix64(x);
+        }
+    }
+
+    uint64_t getSeed() const { return seed; }
+
+    Rng split(uint64_t stream) const {
+        uint64_t x = seed ^ (0x9e3779b97f4a7c15ULL * (stream + 1));
+        return Rng(splitMix64(x));
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()() {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Uniform integer in [0, bound), bound > 0 (Lemire's multiply-shift
+    // with rejection, which rarely needs a division)
+    int below(int bound) { return static_cast<int>(bounded(static_cast<uint32_t>((*this)() >> 32), bound)); }
+
+    // Uniform integer in [low, high]
+    int range(int low, int high) { return low + below(high - low + 1); }
+
+    // Uniform double in [0, 1)
+    double uniform() { return static_cast<double>((*this)() >> 11) * 0x1.0p-53; }
+
+    // count integers in [0, bound), two from every 64-bit draw
+    void fillBelow(int bound, int* out, size_t count) {
+        size_t k = 0;
+        for (; k + 1 < count; k += 2) {
+            uint64_t bits = (*this)();
+            out[k] = static_cast<int>(bounded(static_cast<uint32_t>(bits >> 32), bound));
+            out[k + 1] = static_cast<int>(bounded(static_cast<uint32_t>(bits), bound));
+        }
+        if (k < count) {
+            out[k] = below(bound);
+        }
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    static uint64_t splitMix64(uint64_t& x) {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    uint32_t bounded(uint32_t bits, uint32_t bound) {
+        uint64_t product = static_cast<uint64_t>(bits) * bound;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < bound) {
+            uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+            while (low < threshold) {
+                product = static_cast<uint64_t>(static_cast<uint32_t>((*this)() >> 32)) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    uint64_t seed;
+    uint64_t state[4];
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "solution.hpp"
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Re-planning after the shop floor changed: jobs added, cancelled or
+// re-timed. Instead of solving the new instance from scratch, the previous
+// schedule is repaired and any solver continues from it (setWarmStart):
+//
+//   ChangedInstance changed = applyJobChanges(problem, changes);
+//   Solution start = repairSchedule(changed, previousPermutation);
+//   IteratedGreedy ig(*changed.problem);
+//   ig.setWarmStart(start.getPermutation());
+//   ig.setTermination(shortBudget);
+struct JobChange {
+    enum class Type { Add, Remove, Update };
+
+    Type type;
+    int job;                 // Job of the previous instance (Remove, Update)
+    std::vector<int> times;  // Processing time on every machine (Add, Update)
+};
+
+// Instance after the changes. Jobs that remain keep their relative order
+// but are renumbered 0..k-1; added jobs follow in the order given.
+struct ChangedInstance {
+    std::unique_ptr<Problem> problem;
+    std::vector<int> previousJob;  // Job number before the changes, -1 if added
+    std::vector<int> touchedJobs;  // Added and updated jobs, new numbers
+    int previousNumJobs;
+};
+
+// Throws std::invalid_argument for unknown or already removed jobs, wrong
+// numbers of processing times and an instance left without jobs
+ChangedInstance applyJobChanges(const Problem& previous, const std::vector<JobChange>& changes);
+
+// Warm start for the changed instance: the previous permutation (of the
+// previous job numbers) without the removed and updated jobs, then the
+// touched jobs reinserted at their best positions, largest total
+// processing time first, with Taillard's acceleration, and finally an
+// insertion descent around them (InsertionSearch::descendFrom). Costs
+// O(t*n*m) for t touched jobs plus the descent, far below a full solve.
+Solution repairSchedule(const ChangedInstance& instance, const std::vector<int>& previousPermutation);
+
+// Changes as text, one per line ('#' starts a comment):
+//   add 12 40 7 ...      processing times on every machine
+//   remove 5             job number of the previous instance
+//   update 3 9 14 2 ...
+std::vector<JobChange> readJobChanges(std::istream& in);
+
+// Instance file in the format Problem reads back (machine by machine)
+void writeInstance(const Problem& problem, const std::string& filename);
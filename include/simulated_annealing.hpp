@@ -1,7 +1,7 @@
 #pragma once
 
 #include "metaheuristic.hpp"
-#include <random>
+#include <vector>
 
 class SimulatedAnnealing : public Metaheuristic {
 public:
@@ -16,7 +16,8 @@ public:
     
 private:
     // Components
-    bool acceptWorseSolution(int currentMakespan, int newMakespan);
+    double acceptanceThreshold(int currentMakespan);
+    int evaluateNeighbor(const Solution& current, int pos1, int pos2, double threshold);
     void updateTemperature();
     
     // Parameters
@@ -27,8 +28,5 @@ private:
     // State variables
     double temperature;
     int iterations;
-    
-    // Random number generation
-    std::random_device rd;
-    std::mt19937 gen;
+    std::vector<int> neighbor;
 }; 
\ No newline at end of file
@@ -2,7 +2,9 @@
 
 #include <vector>
 #include <memory>
+#include <cstdint>
 #include "problem.hpp"
+#include "transposition_table.hpp"
 
 class Solution {
 public:
@@ -13,10 +15,20 @@ public:
     Solution& operator=(const Solution& other);
     
     // Getters and setters
+    const Problem& getProblem() const { return problem; }
     const std::vector<int>& getPermutation() const { return permutation; }
-    int getMakespan() const { return makespan; }
+    int getMakespan() const { return makespan; }  // Value of the problem's objective, see Problem::evaluate
+    uint64_t getHash() const { return hash; }
     void setPermutation(const std::vector<int>& newPermutation);
     
+    // For a permutation produced by a solver together with its makespan:
+    // skips validation and evaluation
+    void setPermutation(const std::vector<int>& newPermutation, int knownMakespan);
+    
+    // When set, evaluate() looks the permutation up before computing its
+    // makespan and stores the result. Copies share the same table.
+    void setTranspositionTable(TranspositionTable* table) { transpositionTable = table; }
+    
     // Solution manipulation
     void swap(int i, int j);
     void insert(int i, int j);
@@ -29,4 +41,6 @@ private:
     const Problem& problem;
     std::vector<int> permutation;
     int makespan;
+    uint64_t hash;  // Maintained incrementally, see zobrist.hpp
+    TranspositionTable* transpositionTable;
 }; 
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "metaheuristic.hpp"
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Solvers by short name, configured from "key=value" parameters. Names and
+// keys follow the command line options (--ga-pop -> "ga", "pop"):
+//   neh
+//   ls   iter
+//   ils  iter, perturb
+//   sa   iter, temp, cool
+//   ts   iter, tabu, neighborhood (swap | blocks)
+//   ga   pop, gen, mut, steady (0 | 1)
+//   aco  ants, iter, evap, alpha, beta, model (succession | position), float (0 | 1)
+//   ig   iter, d, temp
+//   bnb  threads, nodes
+// Missing keys keep the solver defaults. Unknown names or keys and
+// malformed values throw std::invalid_argument.
+using SolverParams = std::map<std::string, std::string>;
+
+std::unique_ptr<Metaheuristic> createSolver(const std::string& name, const Problem& problem,
+                                            const SolverParams& params = {});
+
+// Parses "key=value,key=value"; an empty string gives no parameters
+SolverParams parseSolverParams(const std::string& text);
+
+const std::vector<std::string>& solverNames();
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "problem.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <istream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Long-lived solver service (pfsp --serve). Requests and replies are single
+// lines of space-separated key=value fields, the first word naming the
+// command:
+//
+//   solve id=7 instance=data/20_5_1.txt solver=ig time-limit=0.5 seed=42 params=iter=100000,d=4
+//   load name=shop1 jobs=3 machines=2 times=5,9,8,3,2,7   (machine by machine, as in instance files)
+//   cancel id=7
+//   stats
+//   shutdown                                              (socket mode: stop accepting connections)
+//
+// Solve requests take instance (a loaded name, or a file path relative to
+// the server's directory, loaded on first use), solver and params as in include/solver_factory.hpp, plus
+// time-limit, max-evals, seed, ignore-iter-limits=1 and progress=1. They
+// run concurrently on a shared pool of worker threads and reply with
+//
+//   id=7 status=improved makespan=1290 time=0.000412 evaluations=517       (progress=1 only)
+//   id=7 status=done makespan=1278 lower_bound=1232 time=... setup_time=... evaluations=... seed=... permutation=2,16,8,...
+//   id=7 status=error message=...
+//
+// A cancelled request replies status=cancelled with the fields of done, for
+// the best schedule found until then. Replies of different requests
+// interleave in completion order. Loaded instances stay in memory together
+// with the permutations they cache (NEH and the other initial solutions),
+// so repeated requests skip the parsing and construction a cold pfsp run
+// pays for.
+class SolverServer {
+public:
+    // numThreads <= 0 uses all hardware threads
+    explicit SolverServer(int numThreads = 0);
+    ~SolverServer();
+
+    SolverServer(const SolverServer&) = delete;
+    SolverServer& operator=(const SolverServer&) = delete;
+
+    // Handles the requests read from in until end of input, then waits for
+    // the requests still running
+    void serve(std::istream& in, std::ostream& out);
+
+    // Listens on a Unix domain socket, one session per connection, until a
+    // shutdown request; open connections are served to their end
+    void serveSocket(const std::string& path);
+
+    int getNumThreads() const { return static_cast<int>(workers.size()); }
+
+private:
+    struct Session;
+
+    // Handles one request line, replying through the session
+    void handle(const std::shared_ptr<Session>& session, const std::string& line);
+    void solve(const std::shared_ptr<Session>& session, std::map<std::string, std::string> fields);
+    void load(const std::shared_ptr<Session>& session, std::map<std::string, std::string> fields);
+    std::shared_ptr<const Problem> findInstance(const std::string& name);
+    void finish(const std::shared_ptr<Session>& session);
+    void serveConnection(int fd);  // Socket mode, on its own thread
+    void closeConnection(int fd);
+
+    void submit(std::function<void()> task);
+    void work();
+
+    // Worker pool shared by all sessions
+    std::vector<std::thread> workers;
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::deque<std::function<void()>> queue;
+    bool stopping;
+
+    // Instances by name or file path
+    std::mutex instanceMutex;
+    std::map<std::string, std::shared_ptr<const Problem>> instances;
+
+    // Socket connections still being served (their threads are detached)
+    std::mutex connectionMutex;
+    std::condition_variable connectionsClosed;
+    int openConnections;
+
+    std::atomic<long long> requestCount;
+    std::atomic<int> running;
+    std::atomic<bool> shutdownRequested;
+};
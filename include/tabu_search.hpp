@@ -1,12 +1,20 @@
 #pragma once
 
 #include "metaheuristic.hpp"
+#include "insertion_search.hpp"
 #include <vector>
-#include <deque>
 #include <utility>
 
 class TabuSearch : public Metaheuristic {
 public:
+    // Swap: all n(n-1)/2 exchanges.
+    // CriticalBlocks: insertions that move a job of a critical-path block to
+    // the start or end of that block (Nowicki-Smutnicki); moves inside a
+    // block cannot shorten the path, so the rest can be skipped. All
+    // candidate positions of a job are evaluated at once with Taillard's
+    // acceleration.
+    enum class Neighborhood { Swap, CriticalBlocks };
+    
     // Default constructor
     TabuSearch(const Problem& problem);
     
@@ -15,16 +23,36 @@ public:
     
     Solution solve() override;
     
+    void setNeighborhood(Neighborhood type) { neighborhood = type; }
+    
 private:
+    struct Move {
+        int from;
+        int to;
+        int makespan;
+    };
+    
     // Components
-    bool isTabu(int i, int j) const;
-    void updateTabuList(int i, int j);
-    std::pair<int, int> findBestNeighbor();
+    bool isTabu(const std::vector<int>& permutation, int i, int j) const;
+    void updateTabuList(const std::vector<int>& permutation, int i, int j);
+    void updateTabuList(const std::vector<int>& permutation, const Move& move);
+    std::pair<int, int> findBestNeighbor(const Solution& current);
+    Move findBestBlockMove(const Solution& current);
     
     // Parameters
     int maxIterations;
-    int tabuListSize;
+    int tabuListSize;  // Tenure: iterations a reversed move stays forbidden
+    Neighborhood neighborhood;
+    
+    // Tabu memory as a job x position attribute matrix: tabuUntil[job * n + pos]
+    // is the first iteration at which job may again be placed at pos
+    std::vector<int> tabuUntil;
+    int iteration;
     
-    // Tabu list
-    std::deque<std::pair<int, int>> tabuList;
-}; 
\ No newline at end of file
+    // Block neighborhood evaluation
+    InsertionSearch insertion;
+    std::vector<Problem::Block> blocks;
+    std::vector<std::pair<int, int>> candidates;  // (from, to) positions
+    std::vector<int> removed;
+    std::vector<int> makespans;
+};
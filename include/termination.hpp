@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <functional>
+
+class Solution;
+
+// Shared flag that lets another thread ask a running solver to stop.
+// Copies refer to the same flag, so a token can be handed to a solver
+// and cancelled later from the caller's side.
+class CancellationToken {
+public:
+    CancellationToken() : flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+    void cancel() const { flag->store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return flag->load(std::memory_order_relaxed); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> flag;
+};
+
+// Stopping criteria shared by every metaheuristic. A value of 0 disables
+// the corresponding limit.
+struct Termination {
+    double timeLimit = 0.0;         // Wall-clock seconds
+    long long maxEvaluations = 0;   // Objective function evaluations
+    double cpuTimeLimit = 0.0;      // Process CPU seconds
+    CancellationToken cancellation;
+
+    // When set, per-algorithm iteration/generation counts no longer stop the
+    // search and the budget above decides alone. Ignored if no budget is set.
+    bool ignoreIterationLimits = false;
+    
+    // Stop as soon as the incumbent reaches the instance's lower bound,
+    // since it is then proven optimal
+    bool stopAtLowerBound = true;
+
+    bool hasBudget() const {
+        return timeLimit > 0.0 || maxEvaluations > 0 || cpuTimeLimit > 0.0;
+    }
+};
+
+// Called on every new incumbent with the elapsed search time (seconds) and
+// the number of evaluations spent so far.
+using IncumbentCallback = std::function<void(const Solution& incumbent, double elapsedTime, long long evaluations)>;
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+// Bounded, lock-free cache from permutation hash (see zobrist.hpp) to
+// makespan, safe to share between solver threads working on the same
+// problem. Each slot stores the makespan and hash ^ makespan as two relaxed
+// atomics; a torn or overwritten slot fails the check on lookup and is
+// treated as a miss. New entries always replace old ones.
+class TranspositionTable {
+public:
+    // capacity is rounded up to a power of two slots (16 bytes each)
+    explicit TranspositionTable(size_t capacity);
+    
+    bool lookup(uint64_t hash, int& makespan) const;
+    void store(uint64_t hash, int makespan);
+    void clear();
+    
+    size_t getCapacity() const { return mask + 1; }
+    long long getProbes() const { return probes.load(std::memory_order_relaxed); }
+    long long getHits() const { return hits.load(std::memory_order_relaxed); }
+    double getHitRate() const;
+    
+private:
+    struct Slot {
+        std::atomic<uint64_t> check{0};
+        std::atomic<uint64_t> data{0};
+    };
+    
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    mutable std::atomic<long long> probes;
+    mutable std::atomic<long long> hits;
+};
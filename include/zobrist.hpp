@@ -0,0 +1,75 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+// Zobrist-style hashing of permutations over the set of (job, next job)
+// pairs, with -1 standing for the start and -2 for the end of the sequence.
+// A permutation is determined by its pairs, and a swap or insertion changes
+// at most four of them, so the hash is updated in O(1) (a position-based
+// Zobrist key would change for every job an insertion shifts). Pair keys
+// come from a mixing function rather than an n x n random table.
+
+inline uint64_t zobristPairKey(int job, int next) {
+    // splitmix64 finalizer
+    uint64_t x = (static_cast<uint64_t>(static_cast<uint32_t>(job)) << 32) ^ static_cast<uint32_t>(next);
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+inline uint64_t hashPermutation(const int* permutation, int n) {
+    uint64_t hash = 0;
+    int previous = -1;
+    for (int k = 0; k < n; ++k) {
+        hash ^= zobristPairKey(previous, permutation[k]);
+        previous = permutation[k];
+    }
+    return hash ^ zobristPairKey(previous, -2);
+}
+
+inline uint64_t hashPermutation(const std::vector<int>& permutation) {
+    return hashPermutation(permutation.data(), static_cast<int>(permutation.size()));
+}
+
+// Job at a position, or the start/end sentinels outside the sequence
+inline int zobristJobAt(const std::vector<int>& permutation, int position) {
+    if (position < 0) return -1;
+    if (position >= static_cast<int>(permutation.size())) return -2;
+    return permutation[position];
+}
+
+// Hash after moving the job at position i to position j (as Solution::insert)
+inline uint64_t zobristInsertHash(const std::vector<int>& p, uint64_t hash, int i, int j) {
+    if (i == j) return hash;
+    int moved = p[i];
+    int before = zobristJobAt(p, i - 1);
+    int after = zobristJobAt(p, i + 1);
+    hash ^= zobristPairKey(before, moved) ^ zobristPairKey(moved, after) ^ zobristPairKey(before, after);
+    if (i < j) {
+        int next = zobristJobAt(p, j + 1);
+        hash ^= zobristPairKey(p[j], next) ^ zobristPairKey(p[j], moved) ^ zobristPairKey(moved, next);
+    } else {
+        int previous = zobristJobAt(p, j - 1);
+        hash ^= zobristPairKey(previous, p[j]) ^ zobristPairKey(previous, moved) ^ zobristPairKey(moved, p[j]);
+    }
+    return hash;
+}
+
+// Hash after exchanging the jobs at positions i and j
+inline uint64_t zobristSwapHash(const std::vector<int>& p, uint64_t hash, int i, int j) {
+    if (i == j) return hash;
+    if (i > j) std::swap(i, j);
+    if (j == i + 1) {
+        return zobristInsertHash(p, hash, i, j);
+    }
+    int a = p[i];
+    int b = p[j];
+    int beforeA = zobristJobAt(p, i - 1), afterA = p[i + 1];
+    int beforeB = p[j - 1], afterB = zobristJobAt(p, j + 1);
+    hash ^= zobristPairKey(beforeA, a) ^ zobristPairKey(a, afterA) ^ zobristPairKey(beforeB, b) ^ zobristPairKey(b, afterB);
+    hash ^= zobristPairKey(beforeA, b) ^ zobristPairKey(b, afterA) ^ zobristPairKey(beforeB, a) ^ zobristPairKey(a, afterB);
+    return hash;
+}
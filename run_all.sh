@@ -45,16 +45,22 @@ print_help() {
     echo "  --gs-ls             Run grid search on Local Search only"
     echo "  --gs-sa             Run grid search on Simulated Annealing only"
     echo "  --gs-ts             Run grid search on Tabu Search only"
+    echo "  --gs-ig             Run grid search on Iterated Greedy only"
     echo
     echo "Custom parameter ranges (use commas to separate values):"
     echo "  --ga-pop=20,50,100       Set population sizes for GA"
     echo "  --ga-gen=50,100,200      Set max generations for GA"
     echo "  --ga-mut=0.05,0.1,0.2    Set mutation rates for GA"
+    echo "  --ga-steady              Use elitist steady-state replacement in GA"
     echo "  --aco-ants=10,20,30      Set number of ants for ACO"
     echo "  --aco-iter=50,100,150    Set max iterations for ACO"
     echo "  --aco-evap=0.05,0.1,0.2  Set evaporation rates for ACO"
     echo "  --aco-alpha=0.5,1.0,1.5  Set alpha values for ACO"
     echo "  --aco-beta=1.0,2.0,3.0   Set beta values for ACO"
+    echo "  --aco-float              Store ACO pheromones in single precision"
+    echo "  --aco-bounds=0.01,5.0    MAX-MIN pheromone bounds for ACO"
+    echo "  --aco-model=position     ACO pheromone model: succession (default) or position"
+    echo "  --aco-memory=256         Cap in KiB on ACO pheromone tables (position model)"
     echo "  --ils-iter=50,100,200    Set max iterations for ILS"
     echo "  --ils-perturb=2,3,5      Set perturbation strengths for ILS"
     echo "  --ls-iter=500,1000,2000  Set max iterations for LS"
@@ -63,6 +69,11 @@ print_help() {
     echo "  --sa-cool=0.9,0.95,0.98  Set cooling rates for SA"
     echo "  --ts-iter=500,1000,2000  Set max iterations for TS"
     echo "  --ts-tabu=5,10,20        Set tabu list sizes for TS"
+    echo "  --ts-neighborhood=swap   TS neighborhood: blocks (critical path, default) or swap"
+    echo "  --ig-iter=200,500,1000   Set max iterations for IG"
+    echo "  --ig-d=2,4,6             Set destruction sizes for IG"
+    echo "  --ig-temp=0.2,0.4,0.6    Set temperature factors for IG"
+    echo "  --seed=42                Seed for the random choices (random if omitted)"
     echo "  --help                   Display this help message"
 }
 
@@ -103,7 +114,12 @@ while [[ $# -gt 0 ]]; do
             GRID_SEARCH_ARGS="$GRID_SEARCH_ARGS --gs-ts"
             shift
             ;;
-        --ga-pop=*|--ga-gen=*|--ga-mut=*|--aco-ants=*|--aco-iter=*|--aco-evap=*|--aco-alpha=*|--aco-beta=*|--ils-iter=*|--ils-perturb=*|--ls-iter=*|--sa-iter=*|--sa-temp=*|--sa-cool=*|--ts-iter=*|--ts-tabu=*)
+        --gs-ig)
+            RUN_GRID_SEARCH=true
+            GRID_SEARCH_ARGS="$GRID_SEARCH_ARGS --gs-ig"
+            shift
+            ;;
+        --ga-pop=*|--ga-gen=*|--ga-mut=*|--ga-steady|--aco-ants=*|--aco-iter=*|--aco-evap=*|--aco-alpha=*|--aco-beta=*|--aco-float|--aco-bounds=*|--aco-model=*|--aco-memory=*|--ils-iter=*|--ils-perturb=*|--ls-iter=*|--sa-iter=*|--sa-temp=*|--sa-cool=*|--ts-iter=*|--ts-tabu=*|--ts-neighborhood=*|--ig-iter=*|--ig-d=*|--ig-temp=*|--seed=*|--trace-size=*)
             CUSTOM_PARAMS="$CUSTOM_PARAMS $1"
             shift
             ;;
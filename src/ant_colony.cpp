@@ -1,6 +1,9 @@
 #include "ant_colony.hpp"
+#include "profiler.hpp"
 #include <cmath>
 #include <algorithm>
+#include <numeric>
+#include <limits>
 
 AntColony::AntColony(const Problem& problem) 
     : Metaheuristic(problem), 
@@ -9,7 +12,9 @@ AntColony::AntColony(const Problem& problem)
       evaporationRate(0.1),
       alpha(1.0),
       beta(2.0),
-      gen(rd()) {
+      earlyAbandonment(true),
+      abandonedAnts(0),
+      positionBuckets(0) {
     ants.resize(numAnts);
     for (auto& ant : ants) {
         ant.permutation.resize(problem.getNumJobs());
@@ -24,7 +29,9 @@ AntColony::AntColony(const Problem& problem, int numAnts, int maxIterations,
       evaporationRate(evaporationRate),
       alpha(alpha),
       beta(beta),
-      gen(rd()) {
+      earlyAbandonment(true),
+      abandonedAnts(0),
+      positionBuckets(0) {
     ants.resize(numAnts);
     for (auto& ant : ants) {
         ant.permutation.resize(problem.getNumJobs());
@@ -34,17 +41,30 @@ AntColony::AntColony(const Problem& problem, int numAnts, int maxIterations,
 Solution AntColony::solve() {
     startTimer();
     
+    abandonedAnts = 0;
+    for (size_t k = 0; k < ants.size(); ++k) {
+        ants[k].rng = rng.split(k);
+    }
     initializePheromones();
+    initializeHeuristic();
     int iterations = 0;
     
-    while (iterations < maxIterations) {
+    // A warm start is the incumbent the ants have to beat
+    if (hasWarmStart()) {
+        countEvaluations();
+        updateBest(startingSolution());
+    }
+    
+    while (!iterationLimitReached(iterations, maxIterations) && !shouldStop()) {
         constructSolutions();
         updatePheromones();
         
         // Update best solution
         for (const auto& ant : ants) {
-            if (ant.makespan < bestSolution.getMakespan()) {
-                bestSolution.setPermutation(ant.permutation);
+            if (!ant.abandoned && improvesBest(ant.makespan)) {
+                Solution candidate(problem);
+                candidate.setPermutation(ant.permutation);
+                updateBest(candidate);
             }
         }
         
@@ -57,97 +77,250 @@ Solution AntColony::solve() {
 
 void AntColony::initializePheromones() {
     int n = problem.getNumJobs();
-    pheromones.resize(n, std::vector<double>(n, 1.0));
+    int rows = n;
+    
+    if (pheromoneOptions.model == PheromoneModel::JobPosition) {
+        // Each bucket holds n trails (raw value and cached power) plus n
+        // heuristic values
+        size_t bytesPerBucket = static_cast<size_t>(n) *
+            (2 * (pheromoneOptions.singlePrecision ? sizeof(float) : sizeof(double)) + sizeof(double));
+        positionBuckets = n;
+        if (pheromoneOptions.memoryLimit > 0) {
+            size_t affordable = pheromoneOptions.memoryLimit / std::max<size_t>(bytesPerBucket, 1);
+            positionBuckets = static_cast<int>(std::max<size_t>(1, std::min<size_t>(n, affordable)));
+        }
+        rows = positionBuckets;
+    }
+    
+    if (pheromoneOptions.singlePrecision) {
+        pheromonesSingle.initialize(rows, n, 1.0, alpha, pheromoneOptions.minPheromone, pheromoneOptions.maxPheromone);
+    } else {
+        pheromones.initialize(rows, n, 1.0, alpha, pheromoneOptions.minPheromone, pheromoneOptions.maxPheromone);
+    }
 }
 
-void AntColony::constructSolutions() {
+void AntColony::initializeHeuristic() {
+    PFSP_PROFILE_SCOPE("AntColony::initializeHeuristic");
     int n = problem.getNumJobs();
-    std::uniform_real_distribution<> dis(0.0, 1.0);
+    int m = problem.getNumMachines();
+    auto times = [this](int machine, int job) { return problem.getProcessingTime(machine, job); };
     
-    for (auto& ant : ants) {
-        std::vector<bool> used(n, false);
-        ant.permutation[0] = std::uniform_int_distribution<>(0, n-1)(gen);
-        used[ant.permutation[0]] = true;
+    jobTotals.assign(n, 0);
+    for (int j = 0; j < n; ++j) {
+        const int* jobTimes = problem.getJobTimes(j);
+        for (int i = 0; i < m; ++i) {
+            jobTotals[j] += jobTimes[i];
+        }
+    }
+    
+    if (pheromoneOptions.model == PheromoneModel::JobPosition) {
+        // Palmer's slope index: jobs whose times grow along the machines
+        // should come early. Desirability decreases with the distance between
+        // a job's slope rank and the center of the position bucket.
+        std::vector<std::pair<long long, int>> slopes(n);
+        for (int j = 0; j < n; ++j) {
+            long long slope = 0;
+            for (int i = 0; i < m; ++i) {
+                slope += static_cast<long long>(2 * i - m + 1) * times(i, j);
+            }
+            slopes[j] = {-slope, j};
+        }
+        std::sort(slopes.begin(), slopes.end());
+        std::vector<int> rank(n);
+        for (int r = 0; r < n; ++r) {
+            rank[slopes[r].second] = r;
+        }
         
-        // Construct permutation
-        for (int i = 1; i < n; ++i) {
-            std::vector<double> probabilities(n, 0.0);
-            double sum = 0.0;
-            
-            // Calculate probabilities
+        heuristicTable.resize(static_cast<size_t>(positionBuckets) * n);
+        for (int b = 0; b < positionBuckets; ++b) {
+            double center = (b + 0.5) * n / positionBuckets - 0.5;
             for (int j = 0; j < n; ++j) {
-                if (!used[j]) {
-                    probabilities[j] = std::pow(pheromones[ant.permutation[i-1]][j], alpha) *
-                                     std::pow(calculateHeuristic(ant.permutation[i-1], j), beta);
-                    sum += probabilities[j];
-                }
+                double distance = std::abs(rank[j] - center) * 10.0 / n;
+                heuristicTable[b * n + j] = std::pow(1.0 / (1.0 + distance), beta);
             }
-            
-            // Normalize probabilities
-            for (double& prob : probabilities) {
-                prob /= sum;
+        }
+    } else {
+        heuristicTable.resize(static_cast<size_t>(n) * n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                heuristicTable[i * n + j] = std::pow(calculateHeuristic(i, j), beta);
             }
+        }
+    }
+    
+    unvisited.resize(n);
+    cumulative.resize(n);
+    
+    // Data for the incremental makespan and its lower bound
+    machineTotals.assign(m, 0);
+    minTails.assign(m, 0);
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < n; ++j) {
+            machineTotals[i] += times(i, j);
+        }
+    }
+    for (int j = 0; j < n; ++j) {
+        int tail = 0;
+        for (int i = m - 1; i >= 0; --i) {
+            minTails[i] = (j == 0) ? tail : std::min(minTails[i], tail);
+            tail += times(i, j);
+        }
+    }
+    completionTimes.resize(m);
+    remainingWork.resize(m);
+}
+
+size_t AntColony::getPheromoneMemory() const {
+    size_t trails = pheromoneOptions.singlePrecision ? pheromonesSingle.memoryBytes() : pheromones.memoryBytes();
+    return trails + heuristicTable.size() * sizeof(double);
+}
+
+int AntColony::positionBucket(int position) const {
+    return static_cast<int>(static_cast<long long>(position) * positionBuckets / problem.getNumJobs());
+}
+
+void AntColony::constructSolutions() {
+    PFSP_PROFILE_SCOPE("AntColony::constructSolutions");
+    if (pheromoneOptions.singlePrecision) {
+        constructSolutions(pheromonesSingle);
+    } else {
+        constructSolutions(pheromones);
+    }
+}
+
+void AntColony::updatePheromones() {
+    PFSP_PROFILE_SCOPE("AntColony::updatePheromones");
+    if (pheromoneOptions.singlePrecision) {
+        updatePheromones(pheromonesSingle);
+    } else {
+        updatePheromones(pheromones);
+    }
+}
+
+template <typename T>
+void AntColony::constructSolutions(const PheromoneMatrix<T>& trails) {
+    int n = problem.getNumJobs();
+    int m = problem.getNumMachines();
+    const double scalePow = trails.getScalePow();
+    const double minPow = trails.getMinPow();
+    const bool byPosition = pheromoneOptions.model == PheromoneModel::JobPosition;
+    int iterationBest = std::numeric_limits<int>::max();
+    
+    // The incremental evaluation and its bound are those of the makespan;
+    // other objectives evaluate the finished permutation
+    const bool makespanObjective = problem.getObjective() == Objective::Makespan;
+    
+    // Appends a job to the partial schedule; returns true if the ant can
+    // no longer beat the best ant of this iteration
+    auto appendJob = [&](int job) {
+        const int* times = problem.getJobTimes(job);
+        completionTimes[0] += times[0];
+        remainingWork[0] -= times[0];
+        for (int k = 1; k < m; ++k) {
+            completionTimes[k] = std::max(completionTimes[k], completionTimes[k-1]) + times[k];
+            remainingWork[k] -= times[k];
+        }
+        if (!earlyAbandonment || !makespanObjective || iterationBest == std::numeric_limits<int>::max()) {
+            return false;
+        }
+        for (int k = 0; k < m; ++k) {
+            if (completionTimes[k] + remainingWork[k] + minTails[k] > iterationBest) {
+                return true;
+            }
+        }
+        return false;
+    };
+    
+    for (auto& ant : ants) {
+        // Unvisited jobs are kept compact at the front of the buffer; the
+        // chosen one is swapped with the last remaining entry
+        std::iota(unvisited.begin(), unvisited.end(), 0);
+        int remaining = n;
+        int start = 0;
+        std::fill(completionTimes.begin(), completionTimes.end(), 0);
+        remainingWork = machineTotals;
+        ant.abandoned = false;
+        
+        // The succession model has no trail leading to the first job
+        if (!byPosition) {
+            int first = ant.rng.below(n);
+            ant.permutation[0] = first;
+            std::swap(unvisited[first], unvisited[--remaining]);
+            ant.abandoned = appendJob(first);
+            start = 1;
+        }
+        
+        // Construct permutation
+        for (int i = start; i < n && !ant.abandoned; ++i) {
+            int row = byPosition ? positionBucket(i) : ant.permutation[i-1];
+            const T* trail = trails.powRow(row);
+            const double* heuristic = &heuristicTable[row * n];
             
-            // Roulette wheel selection
-            double r = dis(gen);
-            double cumsum = 0.0;
-            int selected = -1;
-            
-            for (int j = 0; j < n; ++j) {
-                if (!used[j]) {
-                    cumsum += probabilities[j];
-                    if (r <= cumsum) {
-                        selected = j;
-                        break;
-                    }
-                }
+            // Prefix sums of pheromone^alpha * heuristic^beta over the unvisited jobs
+            double sum = 0.0;
+            for (int k = 0; k < remaining; ++k) {
+                int job = unvisited[k];
+                sum += std::max(scalePow * trail[job], minPow) * heuristic[job];
+                cumulative[k] = sum;
             }
             
-            if (selected == -1) {
+            // Roulette wheel selection by binary search on the prefix sums
+            int selectedIndex;
+            if (sum > 0.0) {
+                double r = ant.rng.uniform() * sum;
+                selectedIndex = static_cast<int>(std::upper_bound(cumulative.begin(), cumulative.begin() + remaining, r) - cumulative.begin());
+                selectedIndex = std::min(selectedIndex, remaining - 1);
+            } else {
                 // Fallback to random selection
-                std::vector<int> available;
-                for (int j = 0; j < n; ++j) {
-                    if (!used[j]) available.push_back(j);
-                }
-                selected = available[std::uniform_int_distribution<>(0, available.size()-1)(gen)];
+                selectedIndex = ant.rng.below(remaining);
             }
             
-            ant.permutation[i] = selected;
-            used[selected] = true;
+            ant.permutation[i] = unvisited[selectedIndex];
+            std::swap(unvisited[selectedIndex], unvisited[--remaining]);
+            ant.abandoned = appendJob(ant.permutation[i]);
         }
         
-        // Evaluate solution
-        Solution temp(problem);
-        temp.setPermutation(ant.permutation);
-        ant.makespan = temp.getMakespan();
+        // The makespan is already known from the incremental completion times
+        countEvaluations();
+        if (ant.abandoned) {
+            ant.makespan = std::numeric_limits<int>::max();
+            abandonedAnts++;
+            PFSP_PROFILE_COUNT("AntColony::abandonedAnts", 1);
+        } else {
+            ant.makespan = makespanObjective ? completionTimes[m - 1] : problem.evaluate(ant.permutation.data());
+            iterationBest = std::min(iterationBest, ant.makespan);
+        }
     }
 }
 
-void AntColony::updatePheromones() {
+template <typename T>
+void AntColony::updatePheromones(PheromoneMatrix<T>& trails) {
     int n = problem.getNumJobs();
     
-    // Evaporate pheromones
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            pheromones[i][j] *= (1.0 - evaporationRate);
-        }
-    }
+    // Evaporate pheromones (constant time, see PheromoneMatrix)
+    trails.evaporate(evaporationRate);
     
-    // Add new pheromones
+    // Add new pheromones on the entries used by each ant only
     for (const auto& ant : ants) {
-        double contribution = 1.0 / ant.makespan;
+        if (ant.abandoned) {
+            continue;
+        }
+        double contribution = 1.0 / std::max(ant.makespan, 1);  // Tardiness may reach 0
+        if (pheromoneOptions.model == PheromoneModel::JobPosition) {
+            for (int i = 0; i < n; ++i) {
+                trails.deposit(positionBucket(i), ant.permutation[i], contribution);
+            }
+            continue;
+        }
         for (int i = 0; i < n - 1; ++i) {
-            pheromones[ant.permutation[i]][ant.permutation[i+1]] += contribution;
-            pheromones[ant.permutation[i+1]][ant.permutation[i]] += contribution;
+            trails.deposit(ant.permutation[i], ant.permutation[i+1], contribution);
+            trails.deposit(ant.permutation[i+1], ant.permutation[i], contribution);
         }
     }
 }
 
 double AntColony::calculateHeuristic(int i, int j) const {
-    // Calculate average processing time difference
-    double sum = 0.0;
-    for (int m = 0; m < problem.getNumMachines(); ++m) {
-        sum += problem.getProcessingTimes()[m][j] - problem.getProcessingTimes()[m][i];
-    }
-    return 1.0 / (1.0 + std::abs(sum / problem.getNumMachines()));
-} 
\ No newline at end of file
+    // Inverse of the average processing time difference
+    double difference = static_cast<double>(jobTotals[j] - jobTotals[i]) / problem.getNumMachines();
+    return 1.0 / (1.0 + std::abs(difference));
+}
\ No newline at end of file
@@ -0,0 +1,354 @@
+#include "branch_and_bound.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <thread>
+
+BranchAndBound::BranchAndBound(const Problem& problem)
+    : BranchAndBound(problem, 0, 100000000) {}
+
+BranchAndBound::BranchAndBound(const Problem& problem, int numThreads, long long maxNodes)
+    : Metaheuristic(problem),
+      numThreads(numThreads > 0 ? numThreads : std::max(1u, std::thread::hardware_concurrency())),
+      maxNodes(maxNodes),
+      upperBound(0),
+      pending(0),
+      nodes(0),
+      stopSearch(false),
+      hasInitialSolution(false),
+      initialSolution(problem),
+      optimal(false),
+      lowerBound(0) {}
+
+void BranchAndBound::setInitialSolution(const Solution& solution) {
+    initialSolution = solution;
+    hasInitialSolution = true;
+}
+
+double BranchAndBound::getGap() const {
+    if (lowerBound <= 0) {
+        return 0.0;
+    }
+    return static_cast<double>(bestSolution.getMakespan() - lowerBound) / lowerBound;
+}
+
+Solution BranchAndBound::solve() {
+    if (problem.getObjective() != Objective::Makespan) {
+        throw std::invalid_argument("Branch and bound only minimizes the makespan");
+    }
+    Solution start = startingSolution();
+    if (hasInitialSolution && initialSolution.getMakespan() < start.getMakespan()) {
+        start = initialSolution;
+    }
+    startTimer();
+
+    updateBest(start);
+    precompute();
+
+    int n = problem.getNumJobs();
+    int m = problem.getNumMachines();
+    upperBound = start.getMakespan();
+    nodes = 0;
+    stopSearch = false;
+    optimal = false;
+
+    workers.clear();
+    for (int t = 0; t < numThreads; ++t) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+
+    // The bound of the root is the smallest bound of its children
+    Node root{std::vector<int>(n), std::vector<int>(m, 0), 0, 0};
+    std::iota(root.permutation.begin(), root.permutation.end(), 0);
+    pending = 0;
+    Scratch scratch;
+    expand(0, root, scratch);
+    nodes = 1;
+    root.bound = upperBound;
+    for (const Node& child : workers[0]->stack) {
+        root.bound = std::min(root.bound, child.bound);
+    }
+    
+    // Nothing left to prove if the incumbent already meets the instance bound
+    root.bound = std::max(root.bound, problem.getLowerBound());
+    if (root.bound >= upperBound) {
+        stopSearch = true;
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back(&BranchAndBound::work, this, t);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Every schedule not yet ruled out lies below one of the open nodes
+    lowerBound = upperBound;
+    for (const auto& worker : workers) {
+        for (const Node& node : worker->stack) {
+            lowerBound = std::min(lowerBound, node.bound);
+        }
+    }
+    lowerBound = std::max(lowerBound, root.bound);
+    optimal = lowerBound >= bestSolution.getMakespan();
+    evaluations = nodes;
+    workers.clear();
+
+    stopTimer();
+    return bestSolution;
+}
+
+void BranchAndBound::precompute() {
+    int n = problem.getNumJobs();
+    int m = problem.getNumMachines();
+
+    tails.assign(static_cast<size_t>(n) * m, 0);
+    for (int job = 0; job < n; ++job) {
+        const int* times = problem.getJobTimes(job);
+        int after = 0;
+        for (int i = m - 1; i >= 0; --i) {
+            tails[job * m + i] = after;
+            after += times[i];
+        }
+    }
+
+    pairs.clear();
+    for (int k = 0; k + 1 < m; ++k) {
+        pairs.push_back({k, k + 1});
+    }
+    for (int k = 0; k + 2 < m; ++k) {
+        pairs.push_back({k, m - 1});
+    }
+
+    // Johnson's rule with time lags (Mitten): jobs with a <= b first by
+    // increasing a + lag, then the others by decreasing b + lag
+    johnsonOrders.assign(pairs.size(), std::vector<int>(n));
+    lags.assign(pairs.size(), std::vector<int>(n, 0));
+    for (size_t q = 0; q < pairs.size(); ++q) {
+        auto [k, l] = pairs[q];
+        std::vector<int>& lag = lags[q];
+        for (int job = 0; job < n; ++job) {
+            const int* times = problem.getJobTimes(job);
+            for (int h = k + 1; h < l; ++h) {
+                lag[job] += times[h];
+            }
+        }
+
+        std::vector<int>& order = johnsonOrders[q];
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int x, int y) {
+            const int* tx = problem.getJobTimes(x);
+            const int* ty = problem.getJobTimes(y);
+            bool firstX = tx[k] <= tx[l];
+            bool firstY = ty[k] <= ty[l];
+            if (firstX != firstY) {
+                return firstX;
+            }
+            if (firstX) {
+                return tx[k] + lag[x] < ty[k] + lag[y];
+            }
+            return tx[l] + lag[x] > ty[l] + lag[y];
+        });
+    }
+}
+
+void BranchAndBound::work(int id) {
+    Scratch scratch;
+    Node node;
+    int sinceCheck = 0;
+
+    while (!stopSearch.load(std::memory_order_relaxed)) {
+        if (takeNode(id, node)) {
+            // The incumbent may have improved since the node was created
+            if (node.bound < upperBound.load(std::memory_order_relaxed)) {
+                expand(id, node, scratch);
+            }
+            pending.fetch_sub(1);
+            nodes.fetch_add(1, std::memory_order_relaxed);
+
+            if (++sinceCheck >= 256) {
+                sinceCheck = 0;
+                if (limitReached()) {
+                    stopSearch = true;
+                }
+            }
+        } else if (pending.load() == 0) {
+            break;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool BranchAndBound::takeNode(int id, Node& node) {
+    {
+        Worker& own = *workers[id];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.stack.empty()) {
+            node = std::move(own.stack.back());
+            own.stack.pop_back();
+            return true;
+        }
+    }
+
+    for (int k = 1; k < numThreads; ++k) {
+        Worker& victim = *workers[(id + k) % numThreads];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.stack.empty()) {
+            node = std::move(victim.stack.front());
+            victim.stack.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void BranchAndBound::expand(int id, Node& node, Scratch& scratch) {
+    PFSP_PROFILE_SCOPE("BranchAndBound::expand");
+    int n = problem.getNumJobs();
+    int m = problem.getNumMachines();
+
+    // Remaining work and the two shortest tails on every machine, over the
+    // unscheduled jobs
+    scratch.scheduled.assign(n, 0);
+    for (int k = 0; k < node.depth; ++k) {
+        scratch.scheduled[node.permutation[k]] = 1;
+    }
+    scratch.remaining.assign(m, 0);
+    scratch.minTail.assign(m, std::numeric_limits<int>::max());
+    scratch.secondTail.assign(m, std::numeric_limits<int>::max());
+    scratch.minTailJob.assign(m, -1);
+    scratch.childFront.resize(m);
+    for (int pos = node.depth; pos < n; ++pos) {
+        int job = node.permutation[pos];
+        const int* times = problem.getJobTimes(job);
+        for (int i = 0; i < m; ++i) {
+            scratch.remaining[i] += times[i];
+            int tail = tails[job * m + i];
+            if (tail < scratch.minTail[i]) {
+                scratch.secondTail[i] = scratch.minTail[i];
+                scratch.minTail[i] = tail;
+                scratch.minTailJob[i] = job;
+            } else if (tail < scratch.secondTail[i]) {
+                scratch.secondTail[i] = tail;
+            }
+        }
+    }
+
+    scratch.children.clear();
+    for (int pos = node.depth; pos < n; ++pos) {
+        int job = node.permutation[pos];
+        int bound = childBound(node, job, scratch, upperBound.load(std::memory_order_relaxed));
+
+        if (node.depth + 1 == n) {
+            // Complete schedule, the bound is its makespan
+            if (bound < upperBound.load(std::memory_order_relaxed)) {
+                recordSchedule(node.permutation, bound);
+            }
+            continue;
+        }
+        if (bound < upperBound.load(std::memory_order_relaxed)) {
+            Node child{node.permutation, scratch.childFront, node.depth + 1, bound};
+            std::swap(child.permutation[pos], child.permutation[node.depth]);
+            scratch.children.push_back(std::move(child));
+        }
+    }
+
+    // Most promising child last, so it is explored first
+    std::sort(scratch.children.begin(), scratch.children.end(),
+              [](const Node& a, const Node& b) { return a.bound > b.bound; });
+    pending.fetch_add(static_cast<long long>(scratch.children.size()));
+
+    Worker& own = *workers[id];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    for (Node& child : scratch.children) {
+        own.stack.push_back(std::move(child));
+    }
+}
+
+int BranchAndBound::childBound(const Node& parent, int job, Scratch& scratch, int upperBound) const {
+    int n = problem.getNumJobs();
+    int m = problem.getNumMachines();
+    const int* times = problem.getJobTimes(job);
+
+    std::vector<int>& front = scratch.childFront;
+    front[0] = parent.front[0] + times[0];
+    for (int i = 1; i < m; ++i) {
+        front[i] = std::max(front[i - 1], parent.front[i]) + times[i];
+    }
+    if (parent.depth + 1 == n) {
+        return front[m - 1];
+    }
+
+    // Shortest tail among the jobs left after this one
+    auto minTail = [&](int machine) {
+        return scratch.minTailJob[machine] == job ? scratch.secondTail[machine] : scratch.minTail[machine];
+    };
+
+    // LB1: one machine at a time
+    int bound = 0;
+    for (int i = 0; i < m; ++i) {
+        bound = std::max(bound, front[i] + scratch.remaining[i] - times[i] + minTail(i));
+    }
+    if (bound >= upperBound) {
+        return bound;
+    }
+
+    // LB2: optimal two-machine schedule of the remaining jobs, the machines
+    // in between relaxed to the lags
+    for (size_t q = 0; q < pairs.size(); ++q) {
+        auto [k, l] = pairs[q];
+        const std::vector<int>& lag = lags[q];
+        int first = front[k];
+        int second = front[l];
+        for (int other : johnsonOrders[q]) {
+            if (scratch.scheduled[other] || other == job) {
+                continue;
+            }
+            const int* otherTimes = problem.getJobTimes(other);
+            first += otherTimes[k];
+            second = std::max(second, first + lag[other]) + otherTimes[l];
+        }
+        bound = std::max(bound, second + minTail(l));
+        if (bound >= upperBound) {
+            return bound;
+        }
+    }
+    return bound;
+}
+
+void BranchAndBound::recordSchedule(const std::vector<int>& permutation, int makespan) {
+    std::lock_guard<std::mutex> lock(incumbentMutex);
+    if (makespan >= upperBound.load()) {
+        return;
+    }
+    upperBound = makespan;
+    if (makespan <= problem.getLowerBound()) {
+        stopSearch = true;
+    }
+    Solution solution(problem);
+    solution.setPermutation(permutation, makespan);
+    evaluations = nodes.load(std::memory_order_relaxed);  // For the callback and trace
+    updateBest(solution);
+}
+
+bool BranchAndBound::limitReached() {
+    // Metaheuristic::shouldStop keeps per-solver state and is not safe to
+    // call from several threads, so the limits are checked here
+    long long explored = nodes.load(std::memory_order_relaxed);
+    if (termination.cancellation.isCancelled()) {
+        return true;
+    }
+    if (maxNodes > 0 && explored >= maxNodes) {
+        return true;
+    }
+    if (termination.maxEvaluations > 0 && explored >= termination.maxEvaluations) {
+        return true;
+    }
+    if (termination.cpuTimeLimit > 0.0 && elapsedCpuTime() >= termination.cpuTimeLimit) {
+        return true;
+    }
+    return termination.timeLimit > 0.0 && elapsedTime() >= termination.timeLimit;
+}
@@ -0,0 +1,66 @@
+#include "convergence_trace.hpp"
+#include <iomanip>
+
+ConvergenceTrace::ConvergenceTrace(size_t capacity)
+    : slots(new Slot[capacity > 0 ? capacity : 1]), capacity(capacity > 0 ? capacity : 1), head(0) {}
+
+uint64_t ConvergenceTrace::getDropped() const {
+    uint64_t recorded = getRecorded();
+    return recorded > capacity ? recorded - capacity : 0;
+}
+
+std::vector<ConvergenceTrace::Point> ConvergenceTrace::snapshot() const {
+    std::vector<Point> points;
+    uint64_t end = getRecorded();
+    uint64_t begin = end > capacity ? end - capacity : 0;
+    points.reserve(end - begin);
+
+    for (uint64_t index = begin; index < end; ++index) {
+        const Slot& slot = slots[index % capacity];
+        while (true) {
+            uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before > 2 * index + 2) {
+                break;  // Already overwritten by a newer point
+            }
+            Point point;
+            point.time = slot.time.load(std::memory_order_relaxed);
+            point.evaluations = slot.evaluations.load(std::memory_order_relaxed);
+            point.iteration = slot.iteration.load(std::memory_order_relaxed);
+            point.makespan = slot.makespan.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (before == 2 * index + 2 && slot.sequence.load(std::memory_order_relaxed) == before) {
+                points.push_back(point);
+                break;
+            }
+        }
+    }
+    return points;
+}
+
+void ConvergenceTrace::writeCsvHeader(std::ostream& out) {
+    out << "solver,time,evaluations,iteration,makespan\n";
+}
+
+void ConvergenceTrace::writeCsv(std::ostream& out, const std::string& label) const {
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(9);
+    for (const Point& point : snapshot()) {
+        out << label << "," << point.time << "," << point.evaluations << ","
+            << point.iteration << "," << point.makespan << "\n";
+    }
+    out.flags(flags);
+}
+
+void ConvergenceTrace::writeJson(std::ostream& out, const std::string& label) const {
+    std::ios_base::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(9);
+    out << "{\"solver\": \"" << label << "\", \"dropped\": " << getDropped() << ", \"points\": [";
+    bool first = true;
+    for (const Point& point : snapshot()) {
+        out << (first ? "" : ", ") << "[" << point.time << ", " << point.evaluations << ", "
+            << point.iteration << ", " << point.makespan << "]";
+        first = false;
+    }
+    out << "]}";
+    out.flags(flags);
+}
@@ -1,155 +1,261 @@
 #include "genetic_algorithm.hpp"
-#include <random>
+#include "zobrist.hpp"
+#include "profiler.hpp"
 #include <algorithm>
+#include <numeric>
 
 GeneticAlgorithm::GeneticAlgorithm(const Problem& problem) 
     : Metaheuristic(problem), 
       populationSize(50), 
       maxGenerations(100), 
       mutationRate(0.1), 
-      gen(rd()) {}
+      steadyState(false), 
+      current(0), 
+      stamp(0) {}
 
 GeneticAlgorithm::GeneticAlgorithm(const Problem& problem, int populationSize, int maxGenerations, double mutationRate) 
     : Metaheuristic(problem), 
       populationSize(populationSize), 
       maxGenerations(maxGenerations), 
       mutationRate(mutationRate), 
-      gen(rd()) {}
+      steadyState(false), 
+      current(0), 
+      stamp(0) {}
 
 Solution GeneticAlgorithm::solve() {
     startTimer();
     
     initializePopulation();
+    evaluatePopulation();
     int generation = 0;
     
-    while (generation < maxGenerations) {
-        evaluatePopulation();
-        selection();
-        crossover();
-        mutation();
+    while (!iterationLimitReached(generation, maxGenerations) && !shouldStop()) {
+        if (steadyState) {
+            steadyStateGeneration();
+        } else {
+            selection();
+            crossover();
+            mutation();
+            evaluatePopulation();
+        }
         generation++;
     }
     
-    // Find best solution in final population
-    auto bestIndividual = std::min_element(population.begin(), population.end(),
-        [](const Individual& a, const Individual& b) {
-            return a.makespan < b.makespan;
-        });
-    
-    bestSolution.setPermutation(bestIndividual->permutation);
     stopTimer();
     return bestSolution;
 }
 
 void GeneticAlgorithm::initializePopulation() {
-    population.resize(populationSize);
-    for (auto& individual : population) {
-        individual.permutation.resize(problem.getNumJobs());
-        std::iota(individual.permutation.begin(), individual.permutation.end(), 0);
-        std::shuffle(individual.permutation.begin(), individual.permutation.end(), gen);
+    PFSP_PROFILE_SCOPE("GeneticAlgorithm::initializePopulation");
+    int n = problem.getNumJobs();
+    for (auto& arena : arenas) {
+        arena.genes.resize(static_cast<size_t>(populationSize) * n);
+        arena.makespans.assign(populationSize, 0);
+        arena.hashes.assign(populationSize, 0);
+        arena.dirty.assign(populationSize, 1);
+    }
+    current = 0;
+    parents.resize(populationSize);
+    usedStamp.assign(n, 0);
+    stamp = 0;
+    
+    Population& population = arenas[current];
+    for (int p = 0; p < populationSize; ++p) {
+        int* genes = population.individual(p, n);
+        std::iota(genes, genes + n, 0);
+        std::shuffle(genes, genes + n, rng);
+    }
+    
+    // A warm start replaces the first random individual
+    if (hasWarmStart()) {
+        Solution start = startingSolution();
+        std::copy(start.getPermutation().begin(), start.getPermutation().end(), population.individual(0, n));
+    }
+}
+
+void GeneticAlgorithm::evaluate(Population& population, int index) {
+    int n = problem.getNumJobs();
+    const int* genes = population.individual(index, n);
+    uint64_t hash = hashPermutation(genes, n);
+    population.hashes[index] = hash;
+    population.dirty[index] = 0;
+    countEvaluations();
+    
+    // Offspring often recreate a parent or an earlier individual
+    int& makespan = population.makespans[index];
+    // (possibly in an earlier run sharing the table, so a hit can still be
+    // a new best)
+    if (!transpositionTable || !transpositionTable->lookup(hash, makespan)) {
+        makespan = problem.evaluate(genes);
+        if (transpositionTable) {
+            transpositionTable->store(hash, makespan);
+        }
+    }
+    
+    if (improvesBest(population.makespans[index])) {
+        Solution candidate(problem);
+        candidate.setPermutation(std::vector<int>(genes, genes + n));
+        updateBest(candidate);
     }
 }
 
 void GeneticAlgorithm::evaluatePopulation() {
-    for (auto& individual : population) {
-        Solution temp(problem);
-        temp.setPermutation(individual.permutation);
-        individual.makespan = temp.getMakespan();
+    PFSP_PROFILE_SCOPE("GeneticAlgorithm::evaluatePopulation");
+    // Individuals untouched by crossover and mutation keep their makespan
+    Population& population = arenas[current];
+    for (int p = 0; p < populationSize; ++p) {
+        if (population.dirty[p]) {
+            evaluate(population, p);
+        }
     }
 }
 
+int GeneticAlgorithm::tournament() {
+    // Binary tournament, keep the better one
+    const auto& makespans = arenas[current].makespans;
+    int idx[2];
+    rng.fillBelow(populationSize, idx, 2);
+    int idx1 = idx[0];
+    int idx2 = idx[1];
+    return makespans[idx1] < makespans[idx2] ? idx1 : idx2;
+}
+
 void GeneticAlgorithm::selection() {
-    // Tournament selection
-    std::vector<Individual> newPopulation;
-    std::uniform_int_distribution<> dis(0, populationSize - 1);
+    PFSP_PROFILE_SCOPE("GeneticAlgorithm::selection");
+    // Tournament selection by index, individuals are not copied
+    for (int p = 0; p < populationSize; ++p) {
+        parents[p] = tournament();
+    }
+}
+
+void GeneticAlgorithm::orderCrossover(const int* parent1, const int* parent2, int* child, int start, int length) {
+    int n = problem.getNumJobs();
     
-    while (newPopulation.size() < populationSize) {
-        // Select two individuals for tournament
-        int idx1 = dis(gen);
-        int idx2 = dis(gen);
-        
-        // Keep the better one
-        if (population[idx1].makespan < population[idx2].makespan) {
-            newPopulation.push_back(population[idx1]);
-        } else {
-            newPopulation.push_back(population[idx2]);
-        }
+    // New stamp instead of clearing the used-job bitset
+    if (++stamp == 0) {
+        std::fill(usedStamp.begin(), usedStamp.end(), 0);
+        stamp = 1;
+    }
+    
+    // Copy the segment from the first parent
+    for (int j = start; j < start + length; ++j) {
+        child[j] = parent1[j];
+        usedStamp[parent1[j]] = stamp;
     }
     
-    population = newPopulation;
+    // Fill the remaining positions, after the segment and wrapping around,
+    // with the other jobs in the order they appear in the second parent
+    int pos = (start + length) % n;
+    for (int k = 0; k < n; ++k) {
+        int job = parent2[(start + length + k) % n];
+        if (usedStamp[job] != stamp) {
+            child[pos] = job;
+            pos = (pos + 1) % n;
+        }
+    }
 }
 
 void GeneticAlgorithm::crossover() {
-    // Order Crossover (OX)
-    for (size_t i = 0; i < population.size(); i += 2) {
-        if (i + 1 >= population.size()) break;
-        
-        std::uniform_int_distribution<> dis(0, problem.getNumJobs() - 1);
-        int start = dis(gen);
-        int length = dis(gen);
-        
-        if (start + length > problem.getNumJobs()) {
-            length = problem.getNumJobs() - start;
+    PFSP_PROFILE_SCOPE("GeneticAlgorithm::crossover");
+    // Order Crossover (OX), parents read from the current arena and
+    // offspring written to the other one
+    int n = problem.getNumJobs();
+    const Population& population = arenas[current];
+    Population& offspring = arenas[1 - current];
+    for (int i = 0; i < populationSize; i += 2) {
+        int p1 = parents[i];
+        if (i + 1 >= populationSize || p1 == parents[i + 1]) {
+            // No partner, or a clone of itself: pass the parents through
+            // together with their known makespan
+            for (int k = i; k < std::min(i + 2, populationSize); ++k) {
+                const int* source = population.individual(parents[k], n);
+                std::copy(source, source + n, offspring.individual(k, n));
+                offspring.makespans[k] = population.makespans[parents[k]];
+                offspring.hashes[k] = population.hashes[parents[k]];
+                offspring.dirty[k] = population.dirty[parents[k]];
+            }
+            continue;
         }
         
-        // Create offspring
-        Individual child1, child2;
-        child1.permutation.resize(problem.getNumJobs());
-        child2.permutation.resize(problem.getNumJobs());
+        int p2 = parents[i + 1];
+        int start = rng.below(n);
+        int length = std::min(rng.below(n), n - start);
         
-        // Copy segments
-        for (int j = 0; j < length; ++j) {
-            child1.permutation[start + j] = population[i].permutation[start + j];
-            child2.permutation[start + j] = population[i + 1].permutation[start + j];
+        orderCrossover(population.individual(p1, n), population.individual(p2, n),
+                       offspring.individual(i, n), start, length);
+        orderCrossover(population.individual(p2, n), population.individual(p1, n),
+                       offspring.individual(i + 1, n), start, length);
+        offspring.dirty[i] = 1;
+        offspring.dirty[i + 1] = 1;
+    }
+    
+    current = 1 - current;
+}
+
+bool GeneticAlgorithm::mutate(int* genes) {
+    if (rng.uniform() < mutationRate) {
+        // Swap mutation
+        int positions[2];
+        rng.fillBelow(problem.getNumJobs(), positions, 2);
+        int pos1 = positions[0];
+        int pos2 = positions[1];
+        if (pos1 != pos2) {
+            std::swap(genes[pos1], genes[pos2]);
+            return true;
         }
-        
-        // Fill remaining positions
-        std::vector<bool> used1(problem.getNumJobs(), false);
-        std::vector<bool> used2(problem.getNumJobs(), false);
-        
-        for (int j = 0; j < length; ++j) {
-            used1[population[i].permutation[start + j]] = true;
-            used2[population[i + 1].permutation[start + j]] = true;
+    }
+    return false;
+}
+
+void GeneticAlgorithm::mutation() {
+    PFSP_PROFILE_SCOPE("GeneticAlgorithm::mutation");
+    int n = problem.getNumJobs();
+    Population& population = arenas[current];
+    for (int p = 0; p < populationSize; ++p) {
+        if (mutate(population.individual(p, n))) {
+            population.dirty[p] = 1;
         }
+    }
+}
+
+void GeneticAlgorithm::steadyStateGeneration() {
+    PFSP_PROFILE_SCOPE("GeneticAlgorithm::steadyStateGeneration");
+    // As many offspring as a generational step, each pair replacing the
+    // worst individuals only if better. The other arena holds the two
+    // offspring being built.
+    int n = problem.getNumJobs();
+    Population& population = arenas[current];
+    Population& scratch = arenas[1 - current];
+    for (int pair = 0; pair < populationSize / 2 && !shouldStop(); ++pair) {
+        int p1 = tournament();
+        int p2 = tournament();
+        int start = rng.below(n);
+        int length = std::min(rng.below(n), n - start);
         
-        for (int j = 0; j < problem.getNumJobs(); ++j) {
-            int curr1 = (start + length + j) % problem.getNumJobs();
-            int curr2 = (start + length + j) % problem.getNumJobs();
-            
-            for (int k = 0; k < problem.getNumJobs(); ++k) {
-                if (!used1[population[i + 1].permutation[k]]) {
-                    child1.permutation[curr1] = population[i + 1].permutation[k];
-                    used1[population[i + 1].permutation[k]] = true;
-                    break;
-                }
-            }
+        orderCrossover(population.individual(p1, n), population.individual(p2, n),
+                       scratch.individual(0, n), start, length);
+        orderCrossover(population.individual(p2, n), population.individual(p1, n),
+                       scratch.individual(1, n), start, length);
+        
+        for (int c = 0; c < 2; ++c) {
+            mutate(scratch.individual(c, n));
+            evaluate(scratch, c);
             
-            for (int k = 0; k < problem.getNumJobs(); ++k) {
-                if (!used2[population[i].permutation[k]]) {
-                    child2.permutation[curr2] = population[i].permutation[k];
-                    used2[population[i].permutation[k]] = true;
-                    break;
-                }
+            int worst = static_cast<int>(std::max_element(population.makespans.begin(), population.makespans.end()) -
+                                         population.makespans.begin());
+            if (scratch.makespans[c] < population.makespans[worst] &&
+                !contains(population, scratch.hashes[c])) {
+                const int* child = scratch.individual(c, n);
+                std::copy(child, child + n, population.individual(worst, n));
+                population.makespans[worst] = scratch.makespans[c];
+                population.hashes[worst] = scratch.hashes[c];
+                population.dirty[worst] = 0;
             }
         }
-        
-        population[i] = child1;
-        population[i + 1] = child2;
     }
 }
 
-void GeneticAlgorithm::mutation() {
-    std::uniform_real_distribution<> dis(0.0, 1.0);
-    std::uniform_int_distribution<> posDis(0, problem.getNumJobs() - 1);
-    
-    for (auto& individual : population) {
-        if (dis(gen) < mutationRate) {
-            // Swap mutation
-            int pos1 = posDis(gen);
-            int pos2 = posDis(gen);
-            if (pos1 != pos2) {
-                std::swap(individual.permutation[pos1], individual.permutation[pos2]);
-            }
-        }
-    }
-} 
\ No newline at end of file
+bool GeneticAlgorithm::contains(const Population& population, uint64_t hash) const {
+    // Duplicates would let a single permutation take over the population
+    return std::find(population.hashes.begin(), population.hashes.end(), hash) != population.hashes.end();
+}
@@ -5,7 +5,7 @@
 #include <algorithm>
 
 GridSearch::GridSearch(const Problem& problem) 
-    : problem(problem), bestSolution(problem) {}
+    : problem(problem), bestSolution(problem), seed(Rng::randomSeed()) {}
 
 void GridSearch::updateBestSolution(const std::string& algorithm, const std::string& params, const Solution& solution) {
     if (bestSolution.getMakespan() == 0 || solution.getMakespan() < bestSolution.getMakespan()) {
@@ -42,6 +42,10 @@ void GridSearch::runGeneticAlgorithm(const GeneticAlgorithmParams& params) {
             for (double mutationRate : params.mutationRates) {
                 // Create GA with the specific parameters
                 GeneticAlgorithm ga(problem, populationSize, maxGenerations, mutationRate);
+                ga.setTermination(termination);
+                ga.setTranspositionTable(transpositionTable);
+                ga.setSeed(seed);
+                ga.setSteadyState(params.steadyState);
                 Solution solution = ga.solve();
                 double executionTime = ga.getExecutionTime();
                 
@@ -80,6 +84,10 @@ void GridSearch::runAntColony(const AntColonyParams& params) {
                     for (double beta : params.betaValues) {
                         // Create ACO with specific parameters
                         AntColony aco(problem, numAnts, maxIterations, evapRate, alpha, beta);
+                        aco.setTermination(termination);
+                        aco.setTranspositionTable(transpositionTable);
+                        aco.setSeed(seed);
+                        aco.setPheromoneOptions(params.pheromoneOptions);
                         Solution solution = aco.solve();
                         double executionTime = aco.getExecutionTime();
                         
@@ -117,6 +125,9 @@ void GridSearch::runIteratedLocalSearch(const IteratedLocalSearchParams& params)
         for (int perturbationStrength : params.perturbationStrengths) {
             // Create ILS with specific parameters
             IteratedLocalSearch ils(problem, maxIterations, perturbationStrength);
+            ils.setTermination(termination);
+            ils.setTranspositionTable(transpositionTable);
+            ils.setSeed(seed);
             Solution solution = ils.solve();
             double executionTime = ils.getExecutionTime();
             
@@ -145,6 +156,9 @@ void GridSearch::runLocalSearch(const LocalSearchParams& params) {
     for (int maxIterations : params.maxIterations) {
         // Create LS with specific parameters
         LocalSearch ls(problem, maxIterations);
+        ls.setTermination(termination);
+        ls.setTranspositionTable(transpositionTable);
+        ls.setSeed(seed);
         Solution solution = ls.solve();
         double executionTime = ls.getExecutionTime();
         
@@ -175,6 +189,9 @@ void GridSearch::runSimulatedAnnealing(const SimulatedAnnealingParams& params) {
             for (double coolingRate : params.coolingRates) {
                 // Create SA with specific parameters
                 SimulatedAnnealing sa(problem, maxIterations, initialTemp, coolingRate);
+                sa.setTermination(termination);
+                sa.setTranspositionTable(transpositionTable);
+                sa.setSeed(seed);
                 Solution solution = sa.solve();
                 double executionTime = sa.getExecutionTime();
                 
@@ -207,6 +224,10 @@ void GridSearch::runTabuSearch(const TabuSearchParams& params) {
         for (int tabuListSize : params.tabuListSizes) {
             // Create TS with specific parameters
             TabuSearch ts(problem, maxIterations, tabuListSize);
+            ts.setTermination(termination);
+            ts.setTranspositionTable(transpositionTable);
+            ts.setSeed(seed);
+            ts.setNeighborhood(params.neighborhood);
             Solution solution = ts.solve();
             double executionTime = ts.getExecutionTime();
             
@@ -224,6 +245,43 @@ void GridSearch::runTabuSearch(const TabuSearchParams& params) {
     }
 }
 
+void GridSearch::runIteratedGreedy(const IteratedGreedyParams& params) {
+    std::cout << "\nRunning Iterated Greedy Grid Search..." << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    std::cout << std::left << std::setw(15) << "Iterations" << " | "
+              << std::setw(15) << "Destruction" << " | "
+              << std::setw(15) << "Temp Factor" << " | "
+              << std::setw(15) << "Makespan" << " | "
+              << std::setw(15) << "Time (s)" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    for (int maxIterations : params.maxIterations) {
+        for (int destructionSize : params.destructionSizes) {
+            for (double temperatureFactor : params.temperatureFactors) {
+                // Create IG with specific parameters
+                IteratedGreedy ig(problem, maxIterations, destructionSize, temperatureFactor);
+                ig.setTermination(termination);
+                ig.setTranspositionTable(transpositionTable);
+                ig.setSeed(seed);
+                Solution solution = ig.solve();
+                double executionTime = ig.getExecutionTime();
+                
+                std::ostringstream paramStream;
+                paramStream << "iter=" << maxIterations << ",d=" << destructionSize << ",temp=" << temperatureFactor;
+                std::string paramString = paramStream.str();
+                
+                std::cout << std::left << std::setw(15) << maxIterations << " | "
+                          << std::setw(15) << destructionSize << " | "
+                          << std::setw(15) << temperatureFactor << " | "
+                          << std::setw(15) << solution.getMakespan() << " | "
+                          << std::setw(15) << std::fixed << std::setprecision(6) << executionTime << std::endl;
+                
+                updateBestSolution("Iterated Greedy", paramString, solution);
+            }
+        }
+    }
+}
+
 void GridSearch::runAll() {
     // Run grid search for all algorithms with default parameters
     GeneticAlgorithmParams gaParams;
@@ -232,6 +290,7 @@ void GridSearch::runAll() {
     LocalSearchParams lsParams;
     SimulatedAnnealingParams saParams;
     TabuSearchParams tsParams;
+    IteratedGreedyParams igParams;
     
     runGeneticAlgorithm(gaParams);
     runAntColony(acoParams);
@@ -239,6 +298,7 @@ void GridSearch::runAll() {
     runLocalSearch(lsParams);
     runSimulatedAnnealing(saParams);
     runTabuSearch(tsParams);
+    runIteratedGreedy(igParams);
     
     // Print overall best solution
     std::cout << "\n" << std::string(80, '=') << std::endl;
@@ -247,6 +307,8 @@ void GridSearch::runAll() {
     std::cout << "Algorithm: " << bestAlgorithm << std::endl;
     std::cout << "Parameters: " << bestParameters << std::endl;
     std::cout << "Makespan: " << bestSolution.getMakespan() << std::endl;
+    std::cout << "Gap to Lower Bound: " << std::fixed << std::setprecision(2)
+              << 100.0 * problem.relativeGap(bestSolution.getMakespan()) << "%" << std::endl;
     
     // Print the best schedule
     std::cout << "Best Schedule: [";
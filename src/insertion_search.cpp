@@ -0,0 +1,136 @@
+#include "insertion_search.hpp"
+#include "objective.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <numeric>
+#include <limits>
+
+InsertionSearch::InsertionSearch(const Problem& problem)
+    : problem(problem), stopped(false) {}
+
+int InsertionSearch::bestInsertion(const std::vector<int>& sequence, int job, int& bestPosition) {
+    // Only the minimum matters, so positions that cannot beat it may stop early
+    PFSP_PROFILE_SCOPE("InsertionSearch::insertionValues");
+    withObjective(problem.getObjective(), [&](auto policy) {
+        decltype(policy)::insertionValues(problem, sequence, job, candidates, true, buffers);
+    });
+    
+    // Ties keep the earliest position
+    auto best = std::min_element(candidates.begin(), candidates.end());
+    bestPosition = static_cast<int>(best - candidates.begin());
+    return *best;
+}
+
+void InsertionSearch::insertionValues(const std::vector<int>& sequence, int job, std::vector<int>& values) {
+    PFSP_PROFILE_SCOPE("InsertionSearch::insertionValues");
+    withObjective(problem.getObjective(), [&](auto policy) {
+        decltype(policy)::insertionValues(problem, sequence, job, values, false, buffers);
+    });
+}
+
+bool InsertionSearch::sweep(std::vector<int>& permutation, int& makespan, Rng& rng,
+                            const Progress& progress) {
+    PFSP_PROFILE_SCOPE("InsertionSearch::sweep");
+    stopped = false;
+    const int n = static_cast<int>(permutation.size());
+    if (n < 2) {
+        return false;
+    }
+
+    order.resize(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+
+    bool improved = false;
+    for (int job : order) {
+        auto it = std::find(permutation.begin(), permutation.end(), job);
+        removed.assign(permutation.begin(), it);
+        removed.insert(removed.end(), it + 1, permutation.end());
+
+        int position;
+        int newMakespan = bestInsertion(removed, job, position);
+        if (newMakespan < makespan) {
+            removed.insert(removed.begin() + position, job);
+            permutation.swap(removed);
+            makespan = newMakespan;
+            improved = true;
+        }
+
+        if (progress && progress(n)) {
+            stopped = true;
+            break;
+        }
+    }
+
+    return improved;
+}
+
+bool InsertionSearch::descend(std::vector<int>& permutation, int& makespan, Rng& rng,
+                              const Progress& progress) {
+    bool improved = false;
+    while (sweep(permutation, makespan, rng, progress)) {
+        improved = true;
+        if (stopped) {
+            break;
+        }
+    }
+    return improved;
+}
+
+bool InsertionSearch::descendFrom(std::vector<int>& permutation, int& makespan, const std::vector<int>& jobs,
+                                  const Progress& progress) {
+    PFSP_PROFILE_SCOPE("InsertionSearch::descendFrom");
+    stopped = false;
+    const int n = static_cast<int>(permutation.size());
+    if (n < 2) {
+        return false;
+    }
+    
+    looking.assign(n, 0);
+    pending.clear();
+    auto wake = [&](int job) {
+        if (!looking[job]) {
+            looking[job] = 1;
+            pending.push_back(job);
+        }
+    };
+    auto wakeAround = [&](int position) {
+        if (position > 0) wake(permutation[position - 1]);
+        if (position < n - 1) wake(permutation[position + 1]);
+    };
+    for (int job : jobs) {
+        wake(job);
+    }
+    
+    bool improved = false;
+    while (!pending.empty()) {
+        int job = pending.front();
+        pending.pop_front();
+        looking[job] = 0;
+        
+        auto it = std::find(permutation.begin(), permutation.end(), job);
+        int from = static_cast<int>(it - permutation.begin());
+        removed.assign(permutation.begin(), it);
+        removed.insert(removed.end(), it + 1, permutation.end());
+        
+        int position;
+        int newMakespan = bestInsertion(removed, job, position);
+        if (newMakespan < makespan) {
+            // The old and new neighbors of the moved job may now improve
+            wakeAround(from);
+            removed.insert(removed.begin() + position, job);
+            permutation.swap(removed);
+            makespan = newMakespan;
+            improved = true;
+            wake(job);
+            wakeAround(position);
+        }
+        
+        if (progress && progress(n)) {
+            stopped = true;
+            break;
+        }
+    }
+    
+    return improved;
+}
@@ -0,0 +1,108 @@
+#include "iterated_greedy.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <cmath>
+
+IteratedGreedy::IteratedGreedy(const Problem& problem) 
+    : Metaheuristic(problem), 
+      maxIterations(500), 
+      destructionSize(4), 
+      temperatureFactor(0.4), 
+      temperature(1.0), 
+      insertion(problem) {}
+
+IteratedGreedy::IteratedGreedy(const Problem& problem, int maxIterations, int destructionSize, double temperatureFactor) 
+    : Metaheuristic(problem), 
+      maxIterations(maxIterations), 
+      destructionSize(destructionSize), 
+      temperatureFactor(temperatureFactor), 
+      temperature(1.0), 
+      insertion(problem) {}
+
+Solution IteratedGreedy::solve() {
+    Solution initial_solution = startingSolution();
+    startTimer();
+    
+    // Temperature = T * (sum of processing times) / (n * m * 10)
+    int n = problem.getNumJobs();
+    int m = problem.getNumMachines();
+    long long totalTime = 0;
+    for (int j = 0; j < n; ++j) {
+        const int* times = problem.getJobTimes(j);
+        for (int i = 0; i < m; ++i) {
+            totalTime += times[i];
+        }
+    }
+    temperature = std::max(temperatureFactor * totalTime / (10.0 * n * m), 1e-9);
+    
+    auto progress = [this](long long count) {
+        countEvaluations(count);
+        return shouldStop();
+    };
+    
+    std::vector<int> current = initial_solution.getPermutation();
+    int currentMakespan = initial_solution.getMakespan();
+    insertion.descend(current, currentMakespan, rng, progress);
+    
+    Solution candidate = initial_solution;
+    candidate.setPermutation(current);
+    updateBest(candidate);
+    
+    std::vector<int> removedJobs;
+    int iterations = 0;
+    
+    while (!iterationLimitReached(iterations, maxIterations) && !shouldStop()) {
+        std::vector<int> permutation = current;
+        destruction(permutation, removedJobs);
+        int makespan = construction(permutation, removedJobs);
+        insertion.descend(permutation, makespan, rng, progress);
+        
+        if (makespan < currentMakespan || acceptWorseSolution(currentMakespan, makespan)) {
+            current.swap(permutation);
+            currentMakespan = makespan;
+            
+            if (improvesBest(currentMakespan)) {
+                candidate.setPermutation(current);
+                updateBest(candidate);
+            }
+        }
+        
+        iterations++;
+    }
+    
+    stopTimer();
+    return bestSolution;
+}
+
+void IteratedGreedy::destruction(std::vector<int>& permutation, std::vector<int>& removedJobs) {
+    PFSP_PROFILE_SCOPE("IteratedGreedy::destruction");
+    removedJobs.clear();
+    int d = std::min(destructionSize, static_cast<int>(permutation.size()) - 1);
+    for (int k = 0; k < d; ++k) {
+        int pos = rng.below(static_cast<int>(permutation.size()));
+        removedJobs.push_back(permutation[pos]);
+        permutation.erase(permutation.begin() + pos);
+    }
+}
+
+int IteratedGreedy::construction(std::vector<int>& permutation, const std::vector<int>& removedJobs) {
+    PFSP_PROFILE_SCOPE("IteratedGreedy::construction");
+    if (removedJobs.empty()) {
+        countEvaluations();
+        return problem.evaluate(permutation);
+    }
+    
+    int makespan = 0;
+    for (int job : removedJobs) {
+        int pos;
+        makespan = insertion.bestInsertion(permutation, job, pos);
+        countEvaluations(static_cast<long long>(permutation.size()) + 1);
+        permutation.insert(permutation.begin() + pos, job);
+    }
+    return makespan;
+}
+
+bool IteratedGreedy::acceptWorseSolution(int currentMakespan, int newMakespan) {
+    double delta = newMakespan - currentMakespan;
+    return rng.uniform() < std::exp(-delta / temperature);
+}
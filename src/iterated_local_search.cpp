@@ -1,79 +1,159 @@
 #include "iterated_local_search.hpp"
-#include "constructive.hpp"
-#include <random>
+#include "profiler.hpp"
 #include <algorithm>
 #include <numeric>
 
 IteratedLocalSearch::IteratedLocalSearch(const Problem& problem) 
-    : Metaheuristic(problem), maxIterations(100), perturbationStrength(3) {}
+    : Metaheuristic(problem), maxIterations(100), perturbationStrength(3), useInsertion(true),
+      insertion(problem) {}
 
-IteratedLocalSearch::IteratedLocalSearch(const Problem& problem, int maxIterations, int perturbationStrength) 
-    : Metaheuristic(problem), maxIterations(maxIterations), perturbationStrength(perturbationStrength) {}
+IteratedLocalSearch::IteratedLocalSearch(const Problem& problem, int maxIterations, int perturbationStrength,
+                                         bool useInsertion) 
+    : Metaheuristic(problem), maxIterations(maxIterations), perturbationStrength(perturbationStrength),
+      useInsertion(useInsertion), insertion(problem) {}
 
-    Solution IteratedLocalSearch::solve() {
-        Constructive neh = Constructive(problem);
-        Solution initial_solution = neh.solve();
-        startTimer();
-    
-        // Initialize with NEH heuristic
-        
-        
-        bestSolution = initial_solution;
-    
-        Solution current = bestSolution;
-        int iterations = 0;
-    
-        while (iterations < maxIterations) {
-            Solution previous = current;
-            perturbation(current);
-            localSearch(current);
-    
-            // Accept if better or with probability
-            if (current.getMakespan() < bestSolution.getMakespan()) {
-                bestSolution = current;
-            } else {
-                current = previous;
-            }
-    
-            iterations++;
-        }
+Solution IteratedLocalSearch::solve() {
+    Solution initial_solution = startingSolution();
+    startTimer();
+
+    // Initialize with NEH heuristic (or the warm start)
+    updateBest(initial_solution);
+
+    Solution current = bestSolution;
+    current.setTranspositionTable(transpositionTable.get());
+    int iterations = 0;
     
-        stopTimer();
-        return bestSolution;
+    // NEH is not a local optimum, so the first descent looks at every job
+    disturbed.resize(problem.getNumJobs());
+    std::iota(disturbed.begin(), disturbed.end(), 0);
+    localSearch(current);
+    updateBest(current);
+
+    while (!iterationLimitReached(iterations, maxIterations) && !shouldStop()) {
+        iterate(current);
+        iterations++;
+    }
+
+    stopTimer();
+    return bestSolution;
+}
+
+void IteratedLocalSearch::iterate(Solution& current) {
+    Solution previous = current;
+    perturbation(current);
+    localSearch(current);
+
+    // Accept if better or with probability
+    if (!updateBest(current)) {
+        current = previous;
     }
+}
 
 void IteratedLocalSearch::perturbation(Solution& current) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, problem.getNumJobs() - 1);
-    
-    // Perform random swaps
+    PFSP_PROFILE_SCOPE("IteratedLocalSearch::perturbation");
+    // Perform random swaps, then evaluate the result once
+    positions.resize(2 * static_cast<size_t>(perturbationStrength));
+    rng.fillBelow(problem.getNumJobs(), positions.data(), positions.size());
+    working = current.getPermutation();
+    disturbed.clear();
     for (int i = 0; i < perturbationStrength; ++i) {
-        int pos1 = dis(gen);
-        int pos2 = dis(gen);
+        int pos1 = positions[2 * i];
+        int pos2 = positions[2 * i + 1];
         if (pos1 != pos2) {
-            current.swap(pos1, pos2);
+            std::swap(working[pos1], working[pos2]);
+            disturb(working, pos1);
+            disturb(working, pos2);
         }
     }
+    
+    if (!disturbed.empty()) {
+        current.setPermutation(working);
+        countEvaluations();
+    }
+}
+
+void IteratedLocalSearch::disturb(const std::vector<int>& permutation, int position) {
+    // The swapped job and both of its new neighbors
+    int n = static_cast<int>(permutation.size());
+    for (int k = std::max(0, position - 1); k <= std::min(n - 1, position + 1); ++k) {
+        disturbed.push_back(permutation[k]);
+    }
 }
 
 void IteratedLocalSearch::localSearch(Solution& current) {
-    bool improved;
-    do {
-        improved = false;
-        int n = problem.getNumJobs();
+    PFSP_PROFILE_SCOPE("IteratedLocalSearch::localSearch");
+    if (!useInsertion) {
+        swapDescent(current);
+        return;
+    }
+    
+    working = current.getPermutation();
+    int makespan = current.getMakespan();
+    bool improved = insertion.descendFrom(working, makespan, disturbed, [this](long long count) {
+        countEvaluations(count);
+        return shouldStop();
+    });
+    if (improved) {
+        current.setPermutation(working, makespan);
+    }
+}
+
+void IteratedLocalSearch::swapDescent(Solution& current) {
+    // First-improvement swaps with don't-look bits: a job is tried against
+    // every position, and woken up again when a swap changes its neighbors
+    int n = problem.getNumJobs();
+    working = current.getPermutation();
+    int makespan = current.getMakespan();
+    bool improved = false;
+    
+    looking.assign(n, 0);
+    pending.clear();
+    auto wake = [&](int position) {
+        for (int k = std::max(0, position - 1); k <= std::min(n - 1, position + 1); ++k) {
+            int job = working[k];
+            if (!looking[job]) {
+                looking[job] = 1;
+                pending.push_back(job);
+            }
+        }
+    };
+    for (int job : disturbed) {
+        if (!looking[job]) {
+            looking[job] = 1;
+            pending.push_back(job);
+        }
+    }
+    
+    while (!pending.empty() && !shouldStop()) {
+        int job = pending.front();
+        pending.pop_front();
+        looking[job] = 0;
+        int i = static_cast<int>(std::find(working.begin(), working.end(), job) - working.begin());
         
-        // Try swap neighborhood
-        for (int i = 0; i < n - 1; ++i) {
-            for (int j = i + 1; j < n; ++j) {
-                Solution temp = current;
-                temp.swap(i, j);
-                
-                if (temp.getMakespan() < current.getMakespan()) {
-                    current = temp;
-                    improved = true;
-                }
+        for (int j = 0; j < n; ++j) {
+            if (j == i) {
+                continue;
+            }
+            std::swap(working[i], working[j]);
+            // Only improvements matter, so evaluation stops at the current makespan
+            int newMakespan = problem.evaluate(working.data(), makespan);
+            countEvaluations();
+            
+            if (newMakespan < makespan) {
+                makespan = newMakespan;
+                improved = true;
+                wake(i);
+                wake(j);
+                break;
+            }
+            std::swap(working[i], working[j]);
+            if (shouldStop()) {
+                break;
             }
         }
-    } while (improved);
-} 
\ No newline at end of file
+    }
+    
+    if (improved) {
+        current.setPermutation(working, makespan);
+    }
+}
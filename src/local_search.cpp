@@ -1,54 +1,56 @@
 #include "local_search.hpp"
-#include "constructive.hpp"
-#include <random>
+#include "profiler.hpp"
 #include <algorithm>
 #include <numeric>
 
 LocalSearch::LocalSearch(const Problem& problem) 
-    : Metaheuristic(problem), maxIterations(1000) {}
+    : Metaheuristic(problem), maxIterations(1000), insertion(problem) {}
 
 LocalSearch::LocalSearch(const Problem& problem, int maxIterations) 
-    : Metaheuristic(problem), maxIterations(maxIterations) {}
+    : Metaheuristic(problem), maxIterations(maxIterations), insertion(problem) {}
 
 Solution LocalSearch::solve() {
-    Constructive neh = Constructive(problem);
-        Solution initial_solution = neh.solve();
-        startTimer();
-    
-        bestSolution = initial_solution;
-    
-        Solution current = bestSolution;
-        bool improved;
-        int iterations = 0;
-    
-        do {
-            improved = false;
-    
-            // Try different neighborhoods
-            if (swapNeighborhood()) improved = true;
-            if (insertNeighborhood()) improved = true;
-            if (reverseNeighborhood()) improved = true;
-    
-            iterations++;
-        } while (improved && iterations < maxIterations);
-    
-        stopTimer();
-        return bestSolution;
+    Solution initial_solution = startingSolution();
+    startTimer();
+
+    updateBest(initial_solution);
+
+    bool improved;
+    int iterations = 0;
+
+    do {
+        improved = false;
+
+        // Try different neighborhoods
+        if (swapNeighborhood()) improved = true;
+        if (insertNeighborhood()) improved = true;
+        if (reverseNeighborhood()) improved = true;
+
+        iterations++;
+    } while (improved && !iterationLimitReached(iterations, maxIterations) && !shouldStop());
+
+    stopTimer();
+    return bestSolution;
 }
 
 bool LocalSearch::swapNeighborhood() {
+    PFSP_PROFILE_SCOPE("LocalSearch::swapNeighborhood");
     bool improved = false;
     int n = problem.getNumJobs();
     
     for (int i = 0; i < n - 1; ++i) {
         for (int j = i + 1; j < n; ++j) {
             Solution current = bestSolution;
+            current.setTranspositionTable(transpositionTable.get());
             current.swap(i, j);
             
-            if (current.getMakespan() < bestSolution.getMakespan()) {
-                bestSolution = current;
+            countEvaluations();
+            if (updateBest(current)) {
                 improved = true;
             }
+            if (shouldStop()) {
+                return improved;
+            }
         }
     }
     
@@ -56,39 +58,45 @@ bool LocalSearch::swapNeighborhood() {
 }
 
 bool LocalSearch::insertNeighborhood() {
-    bool improved = false;
-    int n = problem.getNumJobs();
+    PFSP_PROFILE_SCOPE("LocalSearch::insertNeighborhood");
+    // One first-improvement pass: each job is removed and all of its
+    // reinsertion positions are evaluated at once
+    std::vector<int> permutation = bestSolution.getPermutation();
+    int makespan = bestSolution.getMakespan();
     
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            if (i != j) {
-                Solution current = bestSolution;
-                current.insert(i, j);
-                
-                if (current.getMakespan() < bestSolution.getMakespan()) {
-                    bestSolution = current;
-                    improved = true;
-                }
-            }
-        }
+    bool improved = insertion.sweep(permutation, makespan, rng, [this](long long count) {
+        countEvaluations(count);
+        return shouldStop();
+    });
+    
+    if (improved) {
+        Solution current = bestSolution;
+        current.setTranspositionTable(transpositionTable.get());
+        current.setPermutation(permutation);
+        updateBest(current);
     }
     
     return improved;
 }
 
 bool LocalSearch::reverseNeighborhood() {
+    PFSP_PROFILE_SCOPE("LocalSearch::reverseNeighborhood");
     bool improved = false;
     int n = problem.getNumJobs();
     
     for (int i = 0; i < n - 1; ++i) {
         for (int j = i + 1; j < n; ++j) {
             Solution current = bestSolution;
+            current.setTranspositionTable(transpositionTable.get());
             current.reverse(i, j);
             
-            if (current.getMakespan() < bestSolution.getMakespan()) {
-                bestSolution = current;
+            countEvaluations();
+            if (updateBest(current)) {
                 improved = true;
             }
+            if (shouldStop()) {
+                return improved;
+            }
         }
     }
     
@@ -1,10 +1,14 @@
 #include <iostream>
 #include <iomanip>
+#include <fstream>
 #include <chrono>
 #include <algorithm>
 #include <sstream>
 #include <string>
+#include <cctype>
+#include <iterator>
 #include "problem.hpp"
+#include "objective.hpp"
 #include "constructive.hpp"
 #include "local_search.hpp"
 #include "iterated_local_search.hpp"
@@ -12,32 +16,60 @@
 #include "tabu_search.hpp"
 #include "genetic_algorithm.hpp"
 #include "ant_colony.hpp"
+#include "iterated_greedy.hpp"
+#include "branch_and_bound.hpp"
 #include "grid_search.hpp"
+#include "solver_server.hpp"
+#include "solver_factory.hpp"
+#include "replanning.hpp"
+#include "profiler.hpp"
 
-void printResults(const std::string& method, const Solution& solution, double executionTime) {
-    // Format execution time with appropriate units based on magnitude
+// Format a duration with appropriate units based on magnitude
+std::string formatTime(double seconds) {
     std::ostringstream timeOss;
-    if (executionTime < 0.000001) { // Less than 1 microsecond
-        timeOss << std::fixed << std::setprecision(2) << (executionTime * 1000000000.0) << " ns";
-    } else if (executionTime < 0.001) { // Less than 1 millisecond
-        timeOss << std::fixed << std::setprecision(2) << (executionTime * 1000000.0) << " µs";
-    } else if (executionTime < 1.0) { // Less than 1 second
-        timeOss << std::fixed << std::setprecision(2) << (executionTime * 1000.0) << " ms";
+    if (seconds < 0.000001) { // Less than 1 microsecond
+        timeOss << std::fixed << std::setprecision(2) << (seconds * 1000000000.0) << " ns";
+    } else if (seconds < 0.001) { // Less than 1 millisecond
+        timeOss << std::fixed << std::setprecision(2) << (seconds * 1000000.0) << " µs";
+    } else if (seconds < 1.0) { // Less than 1 second
+        timeOss << std::fixed << std::setprecision(2) << (seconds * 1000.0) << " ms";
     } else { // 1 second or more
-        timeOss << std::fixed << std::setprecision(3) << executionTime << " s";
+        timeOss << std::fixed << std::setprecision(3) << seconds << " s";
     }
-    std::string timeStr = timeOss.str();
+    return timeOss.str();
+}
+
+// "Makespan", "Flowtime" or "Tardiness", for the objective being minimized
+std::string objectiveLabel(const Problem& problem) {
+    std::string label = objectiveName(problem.getObjective());
+    label[0] = static_cast<char>(std::toupper(static_cast<unsigned char>(label[0])));
+    return label;
+}
+
+// instanceGap: print the gap to the instance lower bound, off for solvers
+// that report a bound of their own
+void printResults(const std::string& method, const Solution& solution, double executionTime, double setupTime = 0.0,
+                  bool instanceGap = true) {
+    std::string timeStr = formatTime(executionTime);
 
     // Print header for this metaheuristic
     std::cout << "\n" << std::string(80, '=') << std::endl;
     std::cout << "Metaheuristic: " << method << std::endl;
     std::cout << std::string(80, '=') << std::endl;
 
-    // Print makespan with high precision
-    std::cout << "Makespan: " << std::fixed << std::setprecision(2) << solution.getMakespan() << std::endl;
+    // Print the objective value with high precision
+    std::cout << objectiveLabel(solution.getProblem()) << ": " << std::fixed << std::setprecision(2) << solution.getMakespan() << std::endl;
     
     // Print execution time with maximum precision
     std::cout << "Execution Time: " << timeStr << std::endl;
+    // A bound of 0 (tardiness) gives no meaningful relative gap
+    if (instanceGap && solution.getProblem().getLowerBound() > 0) {
+        std::cout << "Gap to Lower Bound: " << std::setprecision(2)
+                  << 100.0 * solution.getProblem().relativeGap(solution.getMakespan()) << "%" << std::endl;
+    }
+    if (setupTime > 0.0) {
+        std::cout << "Setup Time: " << formatTime(setupTime) << std::endl;
+    }
     
     // Display the best found schedule in a more readable format
     std::cout << "Best Schedule:" << std::endl;
@@ -50,6 +82,9 @@ void printResults(const std::string& method, const Solution& solution, double ex
         }
     }
     std::cout << "]" << std::endl;
+    
+    // Phase breakdown since the previous report (profiling builds only)
+    PFSP_PROFILE_REPORT(std::cout);
     std::cout << std::string(80, '-') << std::endl;
 }
 
@@ -63,17 +98,54 @@ void printUsage(const char* programName) {
     std::cout << "  --gs-ls             Run grid search on Local Search only" << std::endl;
     std::cout << "  --gs-sa             Run grid search on Simulated Annealing only" << std::endl;
     std::cout << "  --gs-ts             Run grid search on Tabu Search only" << std::endl;
+    std::cout << "  --gs-ig             Run grid search on Iterated Greedy only" << std::endl;
+    std::cout << "  --bnb               Solve exactly with branch and bound (small instances)" << std::endl;
+    std::cout << "  --serve             Answer solve requests read from stdin (see include/solver_server.hpp)" << std::endl;
+    std::cout << "  --serve=/tmp/p.sock Answer solve requests on a Unix socket (client: pfsp_client)" << std::endl;
+    std::cout << "  --serve-threads=8   Requests solved concurrently (default: all hardware threads)" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Re-planning after instance changes (see include/replanning.hpp):" << std::endl;
+    std::cout << "  --replan=schedule.txt    Previous schedule of the input file (job numbers as printed)" << std::endl;
+    std::cout << "  --changes=changes.txt    Lines 'add t1 .. tm', 'remove j' or 'update j t1 .. tm'" << std::endl;
+    std::cout << "  --replan-solver=ig       Solver continuing from the repaired schedule (default: ig)" << std::endl;
+    std::cout << "  --replan-params=d=2      Its parameters as key=value,... (include/solver_factory.hpp)" << std::endl;
+    std::cout << "  --replan-out=new.txt     Write the changed instance, to re-plan from it next time" << std::endl;
+    std::cout << "                           Without a limit, the solver gets --time-limit=0.1 --ignore-iter-limits" << std::endl;
     std::cout << "  --help              Display this help message" << std::endl;
     std::cout << std::endl;
+    std::cout << "Objective (see include/objective.hpp):" << std::endl;
+    std::cout << "  --objective=flowtime     Minimize makespan (default), flowtime or tardiness" << std::endl;
+    std::cout << "  --due-dates=due.txt      Due date of every job in order, needed for tardiness" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Stopping criteria (apply to every algorithm run):" << std::endl;
+    std::cout << "  --time-limit=2.0         Wall-clock limit in seconds" << std::endl;
+    std::cout << "  --cpu-limit=2.0          CPU time limit in seconds" << std::endl;
+    std::cout << "  --max-evals=100000       Maximum number of makespan evaluations" << std::endl;
+    std::cout << "  --ignore-iter-limits     Let the limits above replace iteration counts" << std::endl;
+    std::cout << "  --progress               Print every new best solution as it is found" << std::endl;
+    std::cout << "  --tt-size=64             Cache makespans of visited permutations in a table of this many MiB" << std::endl;
+    std::cout << "  --seed=42                Seed for the random choices (random if omitted)" << std::endl;
+    std::cout << "  --trace=trace.csv        Write every improvement of each run (CSV, or JSON for a .json file)" << std::endl;
+    std::cout << "  --trace-size=4096        Improvements kept per run, the oldest are dropped beyond" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Branch and bound:" << std::endl;
+    std::cout << "  --bnb-threads=4          Worker threads (default: all hardware threads)" << std::endl;
+    std::cout << "  --bnb-nodes=100000000    Node limit, 0 for none (--time-limit also applies)" << std::endl;
+    std::cout << std::endl;
     std::cout << "Parameter customization (use commas to separate multiple values):" << std::endl;
     std::cout << "  --ga-pop=20,50,100       Set population sizes for GA" << std::endl;
     std::cout << "  --ga-gen=50,100,200      Set max generations for GA" << std::endl;
     std::cout << "  --ga-mut=0.05,0.1,0.2    Set mutation rates for GA" << std::endl;
+    std::cout << "  --ga-steady              Use elitist steady-state replacement in GA" << std::endl;
     std::cout << "  --aco-ants=10,20,30      Set number of ants for ACO" << std::endl;
     std::cout << "  --aco-iter=50,100,150    Set max iterations for ACO" << std::endl;
     std::cout << "  --aco-evap=0.05,0.1,0.2  Set evaporation rates for ACO" << std::endl;
     std::cout << "  --aco-alpha=0.5,1.0,1.5  Set alpha values for ACO" << std::endl;
     std::cout << "  --aco-beta=1.0,2.0,3.0   Set beta values for ACO" << std::endl;
+    std::cout << "  --aco-float              Store ACO pheromones in single precision" << std::endl;
+    std::cout << "  --aco-bounds=0.01,5.0    MAX-MIN pheromone bounds for ACO" << std::endl;
+    std::cout << "  --aco-model=position     ACO pheromone model: succession (default) or position" << std::endl;
+    std::cout << "  --aco-memory=256         Cap in KiB on ACO pheromone tables (position model)" << std::endl;
     std::cout << "  --ils-iter=50,100,200    Set max iterations for ILS" << std::endl;
     std::cout << "  --ils-perturb=2,3,5      Set perturbation strengths for ILS" << std::endl;
     std::cout << "  --ls-iter=500,1000,2000  Set max iterations for LS" << std::endl;
@@ -82,6 +154,10 @@ void printUsage(const char* programName) {
     std::cout << "  --sa-cool=0.9,0.95,0.98  Set cooling rates for SA" << std::endl;
     std::cout << "  --ts-iter=500,1000,2000  Set max iterations for TS" << std::endl;
     std::cout << "  --ts-tabu=5,10,20        Set tabu list sizes for TS" << std::endl;
+    std::cout << "  --ts-neighborhood=swap   TS neighborhood: blocks (critical path, default) or swap" << std::endl;
+    std::cout << "  --ig-iter=200,500,1000   Set max iterations for IG" << std::endl;
+    std::cout << "  --ig-d=2,4,6             Set destruction sizes for IG" << std::endl;
+    std::cout << "  --ig-temp=0.2,0.4,0.6    Set temperature factors for IG" << std::endl;
 }
 
 // Helper function to parse comma-separated int values
@@ -118,7 +194,85 @@ std::vector<double> parseDoubleList(const std::string& str) {
     return result;
 }
 
+// Job numbers separated by anything else, so a printed "[2, 16, 8]" also works
+std::vector<int> readSchedule(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file: " + filename);
+    }
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::replace_if(text.begin(), text.end(), [](char c) { return !std::isdigit(static_cast<unsigned char>(c)); }, ' ');
+    std::istringstream iss(text);
+    std::vector<int> schedule;
+    int job;
+    while (iss >> job) {
+        schedule.push_back(job);
+    }
+    return schedule;
+}
+
+// All traces in one file, as CSV rows or as a JSON array depending on the extension
+void writeTraces(const std::string& filename,
+                 const std::vector<std::pair<std::string, std::shared_ptr<ConvergenceTrace>>>& traces) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        throw std::runtime_error("Cannot write " + filename);
+    }
+    bool json = filename.size() >= 5 && filename.compare(filename.size() - 5, 5, ".json") == 0;
+    if (json) {
+        out << "[\n";
+        for (size_t k = 0; k < traces.size(); ++k) {
+            out << "  ";
+            traces[k].second->writeJson(out, traces[k].first);
+            out << (k + 1 < traces.size() ? ",\n" : "\n");
+        }
+        out << "]\n";
+    } else {
+        ConvergenceTrace::writeCsvHeader(out);
+        for (const auto& [name, trace] : traces) {
+            trace->writeCsv(out, name);
+        }
+    }
+}
+
+// Daemon mode: replies own stdout, so nothing else is printed there
+int runServer(int argc, char* argv[]) {
+    std::string socketPath;
+    int threads = 0;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.find("--serve=") == 0) {
+            socketPath = arg.substr(8);
+        } else if (arg.find("--serve-threads=") == 0) {
+            threads = std::stoi(arg.substr(16));
+        } else if (arg != "--serve") {
+            std::cerr << "Warning: Ignoring " << arg << " in server mode" << std::endl;
+        }
+    }
+
+    try {
+        SolverServer server(threads);
+        if (socketPath.empty()) {
+            std::cerr << "Serving requests from stdin with " << server.getNumThreads() << " threads" << std::endl;
+            server.serve(std::cin, std::cout);
+        } else {
+            std::cerr << "Listening on " << socketPath << " with " << server.getNumThreads() << " threads" << std::endl;
+            server.serveSocket(socketPath);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]).find("--serve") == 0) {
+            return runServer(argc, argv);
+        }
+    }
+    
     std::cout << "Starting program..." << std::endl;
     
     // Parse command line arguments
@@ -135,17 +289,23 @@ int main(int argc, char* argv[]) {
     bool runLSGridSearch = false;
     bool runSAGridSearch = false;
     bool runTSGridSearch = false;
+    bool runIGGridSearch = false;
+    bool runBranchAndBound = false;
+    int bnbThreads = 0;
+    long long bnbMaxNodes = 100000000;
     
     // Custom parameter values
     std::vector<int> gaPopSizes;
     std::vector<int> gaMaxGens;
     std::vector<double> gaMutRates;
+    bool gaSteadyState = false;
     
     std::vector<int> acoAnts;
     std::vector<int> acoIters;
     std::vector<double> acoEvapRates;
     std::vector<double> acoAlphas;
     std::vector<double> acoBetas;
+    AntColony::PheromoneOptions acoPheromoneOptions;
     
     std::vector<int> ilsIters;
     std::vector<int> ilsPerturbStrengths;
@@ -158,6 +318,27 @@ int main(int argc, char* argv[]) {
     
     std::vector<int> tsIters;
     std::vector<int> tsTabuSizes;
+    TabuSearch::Neighborhood tsNeighborhood = TabuSearch::Neighborhood::CriticalBlocks;
+    
+    std::vector<int> igIters;
+    std::vector<int> igDestructionSizes;
+    std::vector<double> igTemps;
+    
+    // Stopping criteria
+    Termination termination;
+    bool showProgress = false;
+    size_t ttMegabytes = 0;
+    bool hasSeed = false;
+    uint64_t seed = 0;
+    std::string traceFile;
+    size_t traceSize = 4096;
+    std::string replanFile;
+    std::string changesFile;
+    std::string replanSolver = "ig";
+    std::string replanParams;
+    std::string replanOut;
+    std::string objectiveArg = "makespan";
+    std::string dueDatesFile;
     
     // Process command line arguments
     for (int i = 1; i < argc; ++i) {
@@ -176,6 +357,14 @@ int main(int argc, char* argv[]) {
             runSAGridSearch = true;
         } else if (arg == "--gs-ts") {
             runTSGridSearch = true;
+        } else if (arg == "--gs-ig") {
+            runIGGridSearch = true;
+        } else if (arg == "--bnb") {
+            runBranchAndBound = true;
+        } else if (arg.find("--bnb-threads=") == 0) {
+            bnbThreads = std::stoi(arg.substr(14));
+        } else if (arg.find("--bnb-nodes=") == 0) {
+            bnbMaxNodes = std::stoll(arg.substr(12));
         } else if (arg == "--help") {
             printUsage(argv[0]);
             return 0;
@@ -185,6 +374,8 @@ int main(int argc, char* argv[]) {
             gaMaxGens = parseIntList(arg.substr(9));
         } else if (arg.find("--ga-mut=") == 0) {
             gaMutRates = parseDoubleList(arg.substr(9));
+        } else if (arg == "--ga-steady") {
+            gaSteadyState = true;
         } else if (arg.find("--aco-ants=") == 0) {
             acoAnts = parseIntList(arg.substr(11));
         } else if (arg.find("--aco-iter=") == 0) {
@@ -195,6 +386,27 @@ int main(int argc, char* argv[]) {
             acoAlphas = parseDoubleList(arg.substr(12));
         } else if (arg.find("--aco-beta=") == 0) {
             acoBetas = parseDoubleList(arg.substr(11));
+        } else if (arg == "--aco-float") {
+            acoPheromoneOptions.singlePrecision = true;
+        } else if (arg.find("--aco-bounds=") == 0) {
+            std::vector<double> bounds = parseDoubleList(arg.substr(13));
+            if (bounds.size() == 2) {
+                acoPheromoneOptions.minPheromone = bounds[0];
+                acoPheromoneOptions.maxPheromone = bounds[1];
+            } else {
+                std::cerr << "Warning: --aco-bounds expects MIN,MAX" << std::endl;
+            }
+        } else if (arg.find("--aco-model=") == 0) {
+            std::string model = arg.substr(12);
+            if (model == "position") {
+                acoPheromoneOptions.model = AntColony::PheromoneModel::JobPosition;
+            } else if (model == "succession") {
+                acoPheromoneOptions.model = AntColony::PheromoneModel::JobSuccession;
+            } else {
+                std::cerr << "Warning: Unknown ACO pheromone model: " << model << std::endl;
+            }
+        } else if (arg.find("--aco-memory=") == 0) {
+            acoPheromoneOptions.memoryLimit = static_cast<size_t>(std::stoll(arg.substr(13))) * 1024;
         } else if (arg.find("--ils-iter=") == 0) {
             ilsIters = parseIntList(arg.substr(11));
         } else if (arg.find("--ils-perturb=") == 0) {
@@ -211,6 +423,54 @@ int main(int argc, char* argv[]) {
             tsIters = parseIntList(arg.substr(10));
         } else if (arg.find("--ts-tabu=") == 0) {
             tsTabuSizes = parseIntList(arg.substr(10));
+        } else if (arg.find("--ts-neighborhood=") == 0) {
+            std::string neighborhood = arg.substr(18);
+            if (neighborhood == "swap") {
+                tsNeighborhood = TabuSearch::Neighborhood::Swap;
+            } else if (neighborhood == "blocks") {
+                tsNeighborhood = TabuSearch::Neighborhood::CriticalBlocks;
+            } else {
+                std::cerr << "Warning: Unknown TS neighborhood: " << neighborhood << std::endl;
+            }
+        } else if (arg.find("--ig-iter=") == 0) {
+            igIters = parseIntList(arg.substr(10));
+        } else if (arg.find("--ig-d=") == 0) {
+            igDestructionSizes = parseIntList(arg.substr(7));
+        } else if (arg.find("--ig-temp=") == 0) {
+            igTemps = parseDoubleList(arg.substr(10));
+        } else if (arg.find("--time-limit=") == 0) {
+            termination.timeLimit = std::stod(arg.substr(13));
+        } else if (arg.find("--cpu-limit=") == 0) {
+            termination.cpuTimeLimit = std::stod(arg.substr(12));
+        } else if (arg.find("--max-evals=") == 0) {
+            termination.maxEvaluations = std::stoll(arg.substr(12));
+        } else if (arg == "--ignore-iter-limits") {
+            termination.ignoreIterationLimits = true;
+        } else if (arg == "--progress") {
+            showProgress = true;
+        } else if (arg.find("--tt-size=") == 0) {
+            ttMegabytes = static_cast<size_t>(std::stoll(arg.substr(10)));
+        } else if (arg.find("--trace=") == 0) {
+            traceFile = arg.substr(8);
+        } else if (arg.find("--trace-size=") == 0) {
+            traceSize = static_cast<size_t>(std::stoll(arg.substr(13)));
+        } else if (arg.find("--replan=") == 0) {
+            replanFile = arg.substr(9);
+        } else if (arg.find("--changes=") == 0) {
+            changesFile = arg.substr(10);
+        } else if (arg.find("--replan-solver=") == 0) {
+            replanSolver = arg.substr(16);
+        } else if (arg.find("--replan-params=") == 0) {
+            replanParams = arg.substr(16);
+        } else if (arg.find("--replan-out=") == 0) {
+            replanOut = arg.substr(13);
+        } else if (arg.find("--objective=") == 0) {
+            objectiveArg = arg.substr(12);
+        } else if (arg.find("--due-dates=") == 0) {
+            dueDatesFile = arg.substr(12);
+        } else if (arg.find("--seed=") == 0) {
+            seed = std::stoull(arg.substr(7));
+            hasSeed = true;
         } else {
             // Assume it's the input file
             inputFile = arg;
@@ -226,15 +486,132 @@ int main(int argc, char* argv[]) {
     try {
         std::cout << "Loading problem from file: " << inputFile << std::endl;
         Problem problem(inputFile);
+        Objective objective = parseObjective(objectiveArg);
+        if (!dueDatesFile.empty()) {
+            std::ifstream dueDatesInput(dueDatesFile);
+            if (!dueDatesInput.is_open()) {
+                throw std::runtime_error("Cannot open file: " + dueDatesFile);
+            }
+            std::vector<int> dueDates{std::istream_iterator<int>(dueDatesInput), std::istream_iterator<int>()};
+            problem.setDueDates(dueDates);
+        }
+        problem.setObjective(objective);
+        if (objective != Objective::Makespan) {
+            std::cout << "Objective: " << objectiveName(objective) << std::endl;
+        }
         
         std::cout << "Problem size: " << problem.getNumJobs() << " jobs, "
                   << problem.getNumMachines() << " machines" << std::endl;
+        std::cout << "Lower bound: " << problem.getLowerBound();
+        if (problem.getKnownUpperBound() > 0) {
+            std::cout << ", best known: " << problem.getKnownUpperBound();
+        }
+        std::cout << std::endl;
         
-        // If we're running grid search
-        if (runGridSearch || runGAGridSearch || runACOGridSearch || runILSGridSearch || 
-            runLSGridSearch || runSAGridSearch || runTSGridSearch) {
+        // Printed so that any run can be repeated with --seed
+        if (!hasSeed) {
+            seed = Rng::randomSeed();
+        }
+        std::cout << "Seed: " << seed << std::endl;
+        
+        // One table per instance, shared by every solver run on it
+        std::shared_ptr<TranspositionTable> transpositionTable;
+        if (ttMegabytes > 0) {
+            transpositionTable = std::make_shared<TranspositionTable>(ttMegabytes * 1024 * 1024 / 16);
+        }
+        
+        // Convergence traces of the solvers run below, exported at the end
+        std::vector<std::pair<std::string, std::shared_ptr<ConvergenceTrace>>> traces;
+        
+        // Apply the shared stopping criteria and progress reporting
+        auto configure = [&](Metaheuristic& solver, const std::string& name) {
+            if (!traceFile.empty()) {
+                traces.push_back({name, std::make_shared<ConvergenceTrace>(traceSize)});
+                solver.setConvergenceTrace(traces.back().second);
+            }
+            solver.setTermination(termination);
+            solver.setTranspositionTable(transpositionTable);
+            solver.setSeed(seed);
+            if (showProgress) {
+                solver.setIncumbentCallback([](const Solution& incumbent, double elapsed, long long evals) {
+                    std::cout << "  improved: " << objectiveName(incumbent.getProblem().getObjective())
+                              << " " << incumbent.getMakespan()
+                              << " at " << std::fixed << std::setprecision(6) << elapsed << " s"
+                              << " (" << evals << " evaluations)" << std::endl;
+                });
+            }
+        };
+        
+        if (!replanFile.empty()) {
+            std::vector<JobChange> changes;
+            if (!changesFile.empty()) {
+                std::ifstream changesInput(changesFile);
+                if (!changesInput.is_open()) {
+                    throw std::runtime_error("Cannot open file: " + changesFile);
+                }
+                changes = readJobChanges(changesInput);
+            }
+            
+            auto repairStart = std::chrono::steady_clock::now();
+            ChangedInstance changed = applyJobChanges(problem, changes);
+            if (objective == Objective::Tardiness) {
+                throw std::runtime_error("Re-planning has no due dates for added jobs, use makespan or flowtime");
+            }
+            changed.problem->setObjective(objective);
+            Solution repaired = repairSchedule(changed, readSchedule(replanFile));
+            double repairTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - repairStart).count();
+            std::cout << "Applied " << changes.size() << " changes: " << changed.problem->getNumJobs()
+                      << " jobs, lower bound " << changed.problem->getLowerBound() << std::endl;
+            printResults("Repaired Schedule", repaired, repairTime);
+            
+            // Re-planning is meant to be quick
+            if (!termination.hasBudget()) {
+                termination.timeLimit = 0.1;
+                termination.ignoreIterationLimits = true;
+            }
+            std::unique_ptr<Metaheuristic> solver =
+                createSolver(replanSolver, *changed.problem, parseSolverParams(replanParams));
+            configure(*solver, "Re-planned (" + replanSolver + ")");
+            solver->setWarmStart(repaired.getPermutation());
+            Solution replanned = solver->solve();
+            printResults("Re-planned (" + replanSolver + ")", replanned, solver->getExecutionTime());
+            
+            std::cout << "Previous job numbers (-1: added): [";
+            for (size_t j = 0; j < changed.previousJob.size(); ++j) {
+                std::cout << (j > 0 ? ", " : "") << changed.previousJob[j];
+            }
+            std::cout << "]" << std::endl;
+            if (!replanOut.empty()) {
+                writeInstance(*changed.problem, replanOut);
+                std::cout << "Changed instance written to " << replanOut << std::endl;
+            }
+        } else if (runBranchAndBound) {
+            // A good incumbent prunes far more than NEH, so Iterated Greedy
+            // runs first
+            std::cout << "Running Iterated Greedy for the initial upper bound..." << std::endl;
+            IteratedGreedy ig(problem);
+            configure(ig, "Iterated Greedy");
+            Solution incumbent = ig.solve();
+            
+            std::cout << "Running Branch and Bound..." << std::endl;
+            BranchAndBound bnb(problem, bnbThreads, bnbMaxNodes);
+            configure(bnb, "Branch and Bound");
+            bnb.setInitialSolution(incumbent);
+            Solution bnbSol = bnb.solve();
+            printResults("Branch and Bound", bnbSol, bnb.getExecutionTime(), bnb.getSetupTime(), false);
+            std::cout << "Lower bound: " << bnb.getLowerBound() << " (" << bnb.getNodes() << " nodes)" << std::endl;
+            if (bnb.isOptimal()) {
+                std::cout << "Proven optimal" << std::endl;
+            } else {
+                std::cout << "Gap: " << std::fixed << std::setprecision(2) << 100.0 * bnb.getGap() << "%" << std::endl;
+            }
+        } else if (runGridSearch || runGAGridSearch || runACOGridSearch || runILSGridSearch || 
+            runLSGridSearch || runSAGridSearch || runTSGridSearch || runIGGridSearch) {
             
             GridSearch gridSearch(problem);
+            gridSearch.setTermination(termination);
+            gridSearch.setTranspositionTable(transpositionTable);
+            gridSearch.setSeed(seed);
             
             if (runGridSearch) {
                 // Run grid search on all algorithms with default or custom parameters
@@ -246,6 +623,7 @@ int main(int argc, char* argv[]) {
                         gaPopSizes.empty() ? std::vector<int>{20, 50, 100} : gaPopSizes,
                         gaMaxGens.empty() ? std::vector<int>{50, 100, 200} : gaMaxGens,
                         gaMutRates.empty() ? std::vector<double>{0.05, 0.1, 0.2} : gaMutRates);
+                gaParams.steadyState = gaSteadyState;
                 
                 AntColonyParams acoParams = acoAnts.empty() && acoIters.empty() && acoEvapRates.empty() && acoAlphas.empty() && acoBetas.empty()
                     ? AntColonyParams()
@@ -255,6 +633,7 @@ int main(int argc, char* argv[]) {
                         acoEvapRates.empty() ? std::vector<double>{0.05, 0.1, 0.2} : acoEvapRates,
                         acoAlphas.empty() ? std::vector<double>{0.5, 1.0, 1.5} : acoAlphas,
                         acoBetas.empty() ? std::vector<double>{1.0, 2.0, 3.0} : acoBetas);
+                acoParams.pheromoneOptions = acoPheromoneOptions;
                 
                 IteratedLocalSearchParams ilsParams = ilsIters.empty() && ilsPerturbStrengths.empty()
                     ? IteratedLocalSearchParams()
@@ -278,6 +657,14 @@ int main(int argc, char* argv[]) {
                     : TabuSearchParams(
                         tsIters.empty() ? std::vector<int>{500, 1000, 2000} : tsIters,
                         tsTabuSizes.empty() ? std::vector<int>{5, 10, 20} : tsTabuSizes);
+                tsParams.neighborhood = tsNeighborhood;
+                
+                IteratedGreedyParams igParams = igIters.empty() && igDestructionSizes.empty() && igTemps.empty()
+                    ? IteratedGreedyParams()
+                    : IteratedGreedyParams(
+                        igIters.empty() ? std::vector<int>{200, 500, 1000} : igIters,
+                        igDestructionSizes.empty() ? std::vector<int>{2, 4, 6} : igDestructionSizes,
+                        igTemps.empty() ? std::vector<double>{0.2, 0.4, 0.6} : igTemps);
                 
                 // Run grid search with custom parameters
                 gridSearch.runGeneticAlgorithm(gaParams);
@@ -286,6 +673,7 @@ int main(int argc, char* argv[]) {
                 gridSearch.runLocalSearch(lsParams);
                 gridSearch.runSimulatedAnnealing(saParams);
                 gridSearch.runTabuSearch(tsParams);
+                gridSearch.runIteratedGreedy(igParams);
             } else {
                 // Run grid search on selected algorithms only with custom parameters
                 if (runGAGridSearch) {
@@ -295,6 +683,7 @@ int main(int argc, char* argv[]) {
                             gaPopSizes.empty() ? std::vector<int>{20, 50, 100} : gaPopSizes,
                             gaMaxGens.empty() ? std::vector<int>{50, 100, 200} : gaMaxGens,
                             gaMutRates.empty() ? std::vector<double>{0.05, 0.1, 0.2} : gaMutRates);
+                    gaParams.steadyState = gaSteadyState;
                     gridSearch.runGeneticAlgorithm(gaParams);
                 }
                 
@@ -307,6 +696,7 @@ int main(int argc, char* argv[]) {
                             acoEvapRates.empty() ? std::vector<double>{0.05, 0.1, 0.2} : acoEvapRates,
                             acoAlphas.empty() ? std::vector<double>{0.5, 1.0, 1.5} : acoAlphas,
                             acoBetas.empty() ? std::vector<double>{1.0, 2.0, 3.0} : acoBetas);
+                    acoParams.pheromoneOptions = acoPheromoneOptions;
                     gridSearch.runAntColony(acoParams);
                 }
                 
@@ -342,20 +732,36 @@ int main(int argc, char* argv[]) {
                         : TabuSearchParams(
                             tsIters.empty() ? std::vector<int>{500, 1000, 2000} : tsIters,
                             tsTabuSizes.empty() ? std::vector<int>{5, 10, 20} : tsTabuSizes);
+                    tsParams.neighborhood = tsNeighborhood;
                     gridSearch.runTabuSearch(tsParams);
                 }
                 
+                if (runIGGridSearch) {
+                    IteratedGreedyParams igParams = igIters.empty() && igDestructionSizes.empty() && igTemps.empty()
+                        ? IteratedGreedyParams()
+                        : IteratedGreedyParams(
+                            igIters.empty() ? std::vector<int>{200, 500, 1000} : igIters,
+                            igDestructionSizes.empty() ? std::vector<int>{2, 4, 6} : igDestructionSizes,
+                            igTemps.empty() ? std::vector<double>{0.2, 0.4, 0.6} : igTemps);
+                    gridSearch.runIteratedGreedy(igParams);
+                }
+                
                 // Print the best solution found
                 std::cout << "\n" << std::string(80, '=') << std::endl;
                 std::cout << "BEST SOLUTION FROM GRID SEARCH" << std::endl;
                 std::cout << std::string(80, '=') << std::endl;
                 std::cout << "Algorithm: " << gridSearch.getBestAlgorithm() << std::endl;
                 std::cout << "Parameters: " << gridSearch.getBestParameters() << std::endl;
-                std::cout << "Makespan: " << gridSearch.getBestSolution().getMakespan() << std::endl;
+                std::cout << objectiveLabel(problem) << ": " << gridSearch.getBestSolution().getMakespan() << std::endl;
+                if (problem.getLowerBound() > 0) {
+                    std::cout << "Gap to Lower Bound: " << std::fixed << std::setprecision(2)
+                              << 100.0 * problem.relativeGap(gridSearch.getBestSolution().getMakespan()) << "%" << std::endl;
+                }
                 
                 // Print the best schedule
                 std::cout << "Best Schedule: [";
-                const auto& perm = gridSearch.getBestSolution().getPermutation();
+                Solution gridBest = gridSearch.getBestSolution();
+                const auto& perm = gridBest.getPermutation();
                 for (size_t i = 0; i < perm.size(); ++i) {
                     std::cout << perm[i];
                     if (i < perm.size() - 1) {
@@ -364,50 +770,69 @@ int main(int argc, char* argv[]) {
                 }
                 std::cout << "]" << std::endl;
             }
+            
+            // Phase breakdown over the whole grid
+            PFSP_PROFILE_REPORT(std::cout);
         } else {
             // Run all metaheuristics with default parameters
             std::cout << std::string(80, '-') << std::endl;
             std::cout << std::setw(25) << "Method" << " | "
-                      << std::setw(10) << "Makespan" << " | "
+                      << std::setw(10) << objectiveLabel(problem) << " | "
                       << std::setw(15) << "Time" << " | " << std::endl;
             std::cout << std::string(80, '-') << std::endl;
             
             // Run each metaheuristic
             std::cout << "Running Constructive..." << std::endl;
             Constructive constructive(problem);
+            configure(constructive, "Constructive");
             Solution constructiveSol = constructive.solve();
             printResults("Constructive", constructiveSol, constructive.getExecutionTime());
             
             std::cout << "Running Local Search..." << std::endl;
             LocalSearch localSearch(problem);
+            configure(localSearch, "Local Search");
             Solution localSearchSol = localSearch.solve();
-            printResults("Local Search", localSearchSol, localSearch.getExecutionTime());
+            printResults("Local Search", localSearchSol, localSearch.getExecutionTime(), localSearch.getSetupTime());
             
             std::cout << "Running Iterated Local Search..." << std::endl;
             IteratedLocalSearch ils(problem);
+            configure(ils, "Iterated Local Search");
             Solution ilsSol = ils.solve();
-            printResults("Iterated Local Search", ilsSol, ils.getExecutionTime());
+            printResults("Iterated Local Search", ilsSol, ils.getExecutionTime(), ils.getSetupTime());
             
             std::cout << "Running Simulated Annealing..." << std::endl;
             SimulatedAnnealing sa(problem);
+            configure(sa, "Simulated Annealing");
             Solution saSol = sa.solve();
-            printResults("Simulated Annealing", saSol, sa.getExecutionTime());
+            printResults("Simulated Annealing", saSol, sa.getExecutionTime(), sa.getSetupTime());
             
             std::cout << "Running Tabu Search..." << std::endl;
             TabuSearch ts(problem);
+            configure(ts, "Tabu Search");
+            ts.setNeighborhood(tsNeighborhood);
             Solution tsSol = ts.solve();
-            printResults("Tabu Search", tsSol, ts.getExecutionTime());
+            printResults("Tabu Search", tsSol, ts.getExecutionTime(), ts.getSetupTime());
             
             std::cout << "Running Genetic Algorithm..." << std::endl;
             GeneticAlgorithm ga(problem);
+            configure(ga, "Genetic Algorithm");
+            ga.setSteadyState(gaSteadyState);
             Solution gaSol = ga.solve();
             printResults("Genetic Algorithm", gaSol, ga.getExecutionTime());
             
             std::cout << "Running Ant Colony Optimization..." << std::endl;
             AntColony aco(problem);
+            configure(aco, "Ant Colony Optimization");
+            aco.setPheromoneOptions(acoPheromoneOptions);
             Solution acoSol = aco.solve();
             printResults("Ant Colony Optimization", acoSol, aco.getExecutionTime());
             
+            std::cout << "Running Iterated Greedy..." << std::endl;
+            IteratedGreedy ig(problem);
+            configure(ig, "Iterated Greedy");
+            Solution igSol = ig.solve();
+            printResults("Iterated Greedy", igSol, ig.getExecutionTime(), ig.getSetupTime());
+            
             std::cout << std::string(80, '-') << std::endl;
             
             // Print overall best solution
@@ -418,7 +843,8 @@ int main(int argc, char* argv[]) {
                 {"Simulated Annealing", saSol},
                 {"Tabu Search", tsSol},
                 {"Genetic Algorithm", gaSol},
-                {"Ant Colony Optimization", acoSol}
+                {"Ant Colony Optimization", acoSol},
+                {"Iterated Greedy", igSol}
             };
             
             auto bestSolution = std::min_element(
@@ -430,7 +856,24 @@ int main(int argc, char* argv[]) {
             );
             
             std::cout << "Best overall solution: " << bestSolution->first 
-                      << " with makespan " << bestSolution->second.getMakespan() << std::endl;
+                      << " with " << objectiveName(problem.getObjective()) << " " << bestSolution->second.getMakespan();
+            if (problem.getLowerBound() > 0) {
+                std::cout << " (" << std::fixed << std::setprecision(2)
+                          << 100.0 * problem.relativeGap(bestSolution->second.getMakespan())
+                          << "% above the lower bound)";
+            }
+            std::cout << std::endl;
+        }
+        
+        if (transpositionTable) {
+            std::cout << "Transposition table: " << transpositionTable->getProbes() << " probes, "
+                      << std::fixed << std::setprecision(1) << 100.0 * transpositionTable->getHitRate()
+                      << "% hits (" << transpositionTable->getCapacity() << " slots)" << std::endl;
+        }
+        
+        if (!traceFile.empty()) {
+            writeTraces(traceFile, traces);
+            std::cout << "Convergence traces written to " << traceFile << std::endl;
         }
         
     } catch (const std::exception& e) {
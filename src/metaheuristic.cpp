@@ -1,15 +1,103 @@
 #include "metaheuristic.hpp"
+#include "constructive.hpp"
 #include <chrono>
 
-Metaheuristic::Metaheuristic(const Problem& problem) 
-    : problem(problem), bestSolution(problem), executionTime(0.0) {}
+Metaheuristic::Metaheuristic(const Problem& problem)
+    : problem(problem), bestSolution(problem), executionTime(0.0), setupTime(0.0), evaluations(0),
+      rng(Rng::randomSeed()), startCpuTime(0), pollCountdown(0), currentIteration(0), stopped(false), hasIncumbent(false) {}
+
+Solution Metaheuristic::startingSolution() {
+    if (hasWarmStart()) {
+        Solution start(problem);
+        start.setPermutation(warmStart);
+        setupTime = 0.0;
+        return start;
+    }
+    Constructive neh = Constructive(problem);
+    neh.setSeed(getSeed());
+    Solution start = neh.solve();
+    setupTime = neh.getExecutionTime();
+    return start;
+}
 
 void Metaheuristic::startTimer() {
-    startTime = std::chrono::high_resolution_clock::now();
+    startTime = std::chrono::steady_clock::now();
+    startCpuTime = std::clock();
+    evaluations = 0;
+    pollCountdown = 0;
+    currentIteration = 0;
+    stopped = false;
+    hasIncumbent = false;
 }
 
 void Metaheuristic::stopTimer() {
-    auto endTime = std::chrono::high_resolution_clock::now();
+    auto endTime = std::chrono::steady_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime);
     executionTime = duration.count() / 1000000000.0;
-} 
\ No newline at end of file
+}
+
+double Metaheuristic::elapsedTime() const {
+    auto duration = std::chrono::steady_clock::now() - startTime;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count() / 1000000000.0;
+}
+
+double Metaheuristic::elapsedCpuTime() const {
+    return static_cast<double>(std::clock() - startCpuTime) / CLOCKS_PER_SEC;
+}
+
+bool Metaheuristic::shouldStop() {
+    if (stopped) {
+        return true;
+    }
+
+    if (termination.cancellation.isCancelled() ||
+        (termination.maxEvaluations > 0 && evaluations >= termination.maxEvaluations)) {
+        stopped = true;
+        return true;
+    }
+
+    // Reading the clocks costs far more than the checks above, so only do it
+    // every few calls
+    if (--pollCountdown > 0) {
+        return false;
+    }
+    pollCountdown = clockPollInterval;
+
+    if (termination.timeLimit > 0.0 && elapsedTime() >= termination.timeLimit) {
+        stopped = true;
+    } else if (termination.cpuTimeLimit > 0.0 && elapsedCpuTime() >= termination.cpuTimeLimit) {
+        stopped = true;
+    }
+    return stopped;
+}
+
+bool Metaheuristic::iterationLimitReached(int iteration, int limit) {
+    currentIteration = iteration;
+    if (termination.ignoreIterationLimits && termination.hasBudget()) {
+        return false;
+    }
+    return iteration >= limit;
+}
+
+bool Metaheuristic::updateBest(const Solution& candidate) {
+    if (!improvesBest(candidate.getMakespan())) {
+        return false;
+    }
+
+    bestSolution = candidate;
+    bestSolution.setTranspositionTable(nullptr);  // Results must not outlive the table
+    hasIncumbent = true;
+    if (termination.stopAtLowerBound && bestSolution.getMakespan() <= problem.getLowerBound()) {
+        stopped = true;
+    }
+    if (convergenceTrace || onIncumbent) {
+        double elapsed = elapsedTime();
+        if (convergenceTrace) {
+            convergenceTrace->record({elapsed, evaluations, currentIteration, bestSolution.getMakespan()});
+        }
+        if (onIncumbent) {
+            onIncumbent(bestSolution, elapsed, evaluations);
+        }
+    }
+    return true;
+}
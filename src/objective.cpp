@@ -0,0 +1,23 @@
+#include "objective.hpp"
+#include <stdexcept>
+
+const char* objectiveName(Objective objective) {
+    switch (objective) {
+        case Objective::Flowtime:
+            return "flowtime";
+        case Objective::Tardiness:
+            return "tardiness";
+        case Objective::Makespan:
+        default:
+            return "makespan";
+    }
+}
+
+Objective parseObjective(const std::string& name) {
+    for (Objective objective : {Objective::Makespan, Objective::Flowtime, Objective::Tardiness}) {
+        if (name == objectiveName(objective)) {
+            return objective;
+        }
+    }
+    throw std::invalid_argument("Unknown objective: " + name + " (makespan, flowtime or tardiness)");
+}
@@ -0,0 +1,510 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "problem.hpp"
+#include "objective.hpp"
+#include "random.hpp"
+#include "constructive.hpp"
+#include "insertion_search.hpp"
+#include "local_search.hpp"
+#include "iterated_local_search.hpp"
+#include "simulated_annealing.hpp"
+#include "tabu_search.hpp"
+#include "genetic_algorithm.hpp"
+#include "ant_colony.hpp"
+#include "iterated_greedy.hpp"
+
+// Microbenchmarks for the evaluation kernels, the move evaluations, NEH and
+// one iteration of every metaheuristic, over a grid of random Taillard-like
+// instances. Timings are written as JSON and can be compared against a
+// previous run to catch regressions.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    std::vector<std::pair<int, int>> sizes;  // (jobs, machines)
+    std::vector<std::string> filters;        // Name prefixes, empty for all
+    int warmup = 2;
+    int reps = 15;
+    double maxSeconds = 1.0;                 // Sampling budget per benchmark
+    double sampleSeconds = 0.0002;           // Minimum duration of one sample
+    long seed = 873654221;
+    std::string outputFile;
+    std::string baselineFile;
+    double tolerance = 0.10;
+};
+
+struct Result {
+    std::string name;
+    int jobs;
+    int machines;
+    int reps;
+    long long batch;   // Operations timed together in one sample
+    double medianNs;   // Per operation
+    double p95Ns;
+    double minNs;
+};
+
+// Keeps results alive so the compiler cannot drop the timed work
+volatile long long sink = 0;
+
+// Taillard's generator (1993): processing times uniform in [1, 99] drawn
+// machine by machine from a Lehmer sequence, so the grid is the same on
+// every machine and every run
+std::vector<std::vector<int>> taillardTimes(int jobs, int machines, long seed) {
+    auto unif = [&seed](int low, int high) {
+        const long m = 2147483647, a = 16807, b = 127773, c = 2836;
+        long k = seed / b;
+        seed = a * (seed % b) - k * c;
+        if (seed < 0) {
+            seed += m;
+        }
+        double value = static_cast<double>(seed) / m;
+        return low + static_cast<int>(value * (high - low + 1));
+    };
+    std::vector<std::vector<int>> times(machines, std::vector<int>(jobs));
+    for (int i = 0; i < machines; ++i) {
+        for (int j = 0; j < jobs; ++j) {
+            times[i][j] = unif(1, 99);
+        }
+    }
+    return times;
+}
+
+class Bench {
+public:
+    explicit Bench(const Options& options) : options(options) {}
+
+    bool enabled(const std::string& name) const {
+        if (options.filters.empty()) {
+            return true;
+        }
+        for (const auto& filter : options.filters) {
+            if (name.compare(0, filter.size(), filter) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Times op() in batches long enough for the clock, after warmup batches
+    template <typename Op>
+    void run(const std::string& name, const Problem& problem, Op&& op) {
+        if (!enabled(name)) {
+            return;
+        }
+
+        // Calibrate the batch size on the first calls, which double as warmup
+        long long batch = 1;
+        double elapsed;
+        while (true) {
+            elapsed = timeBatch(op, batch);
+            if (elapsed >= options.sampleSeconds || batch >= (1LL << 30)) {
+                break;
+            }
+            batch *= 2;
+        }
+        
+        // A single call longer than the whole budget (full neighborhoods on
+        // the largest instances) is warm already and sampled only once
+        bool slow = elapsed >= options.maxSeconds;
+        size_t minSamples = slow ? 1 : 3;
+        for (int w = 0; w < options.warmup && !slow; ++w) {
+            timeBatch(op, batch);
+        }
+
+        std::vector<double> samples;
+        auto start = Clock::now();
+        for (int r = 0; r < options.reps; ++r) {
+            samples.push_back(timeBatch(op, batch) * 1e9 / batch);
+            double spent = std::chrono::duration<double>(Clock::now() - start).count();
+            if (samples.size() >= minSamples && spent >= options.maxSeconds) {
+                break;
+            }
+        }
+        std::sort(samples.begin(), samples.end());
+
+        Result result;
+        result.name = name;
+        result.jobs = problem.getNumJobs();
+        result.machines = problem.getNumMachines();
+        result.reps = static_cast<int>(samples.size());
+        result.batch = batch;
+        result.medianNs = percentile(samples, 0.5);
+        result.p95Ns = percentile(samples, 0.95);
+        result.minNs = samples.front();
+        results.push_back(result);
+
+        std::cerr << std::left << std::setw(22) << name << std::right
+                  << std::setw(6) << result.jobs << "x" << std::left << std::setw(4) << result.machines
+                  << std::right << std::fixed << std::setprecision(1)
+                  << " median " << std::setw(14) << result.medianNs << " ns"
+                  << "  p95 " << std::setw(14) << result.p95Ns << " ns"
+                  << "  (" << result.reps << " x " << batch << ")" << std::endl;
+    }
+
+    const std::vector<Result>& getResults() const { return results; }
+
+private:
+    template <typename Op>
+    static double timeBatch(Op& op, long long batch) {
+        auto start = Clock::now();
+        for (long long k = 0; k < batch; ++k) {
+            op();
+        }
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    static double percentile(const std::vector<double>& sorted, double fraction) {
+        size_t index = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+        return sorted[std::min(sorted.size() - 1, index > 0 ? index - 1 : 0)];
+    }
+
+    const Options& options;
+    std::vector<Result> results;
+};
+
+// Evaluation kernels and moves. Moves are applied to a random permutation,
+// evaluated in full and undone, cycling through pregenerated positions.
+void benchKernels(Bench& bench, const Problem& problem, Rng& rng) {
+    const int n = problem.getNumJobs();
+    std::vector<int> permutation(n);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    std::shuffle(permutation.begin(), permutation.end(), rng);
+
+    const size_t numMoves = 1024;
+    std::vector<int> positions(2 * numMoves);
+    rng.fillBelow(n, positions.data(), positions.size());
+    size_t next = 0;
+    auto nextMove = [&](int& a, int& b) {
+        a = positions[next];
+        b = positions[next + 1];
+        next = (next + 2) % positions.size();
+    };
+
+    bench.run("makespan", problem, [&] {
+        sink = sink + problem.calculateMakespan(permutation.data());
+    });
+
+    bench.run("swap_move", problem, [&] {
+        int a, b;
+        nextMove(a, b);
+        std::swap(permutation[a], permutation[b]);
+        sink = sink + problem.calculateMakespan(permutation.data());
+        std::swap(permutation[a], permutation[b]);
+    });
+
+    bench.run("insert_move", problem, [&] {
+        int from, to;
+        nextMove(from, to);
+        auto first = permutation.begin();
+        if (from < to) {
+            std::rotate(first + from, first + from + 1, first + to + 1);
+            sink = sink + problem.calculateMakespan(permutation.data());
+            std::rotate(first + from, first + to, first + to + 1);
+        } else {
+            std::rotate(first + to, first + from, first + from + 1);
+            sink = sink + problem.calculateMakespan(permutation.data());
+            std::rotate(first + to, first + to + 1, first + from + 1);
+        }
+    });
+
+    bench.run("reverse_move", problem, [&] {
+        int a, b;
+        nextMove(a, b);
+        if (a > b) {
+            std::swap(a, b);
+        }
+        std::reverse(permutation.begin() + a, permutation.begin() + b + 1);
+        sink = sink + problem.calculateMakespan(permutation.data());
+        std::reverse(permutation.begin() + a, permutation.begin() + b + 1);
+    });
+
+    // All n positions of one job at once, with heads and tails
+    InsertionSearch insertion(problem);
+    std::vector<int> removed(permutation.begin(), permutation.end() - 1);
+    std::vector<int> makespans;
+    bench.run("insert_all", problem, [&] {
+        insertion.insertionValues(removed, permutation.back(), makespans);
+        sink = sink + makespans[0];
+    });
+    // Only the best position, which lets the sum objectives stop early
+    bench.run("best_insert", problem, [&] {
+        int position;
+        sink = sink + insertion.bestInsertion(removed, permutation.back(), position);
+    });
+
+    // The same kernels for the sum objectives, on a view of the instance
+    // with due dates spread over the second half of the makespan bound
+    Problem sums(n, problem.getNumMachines(), problem.getJobTimes(0));
+    std::vector<int> dueDates(n);
+    for (int& date : dueDates) {
+        date = static_cast<int>(problem.getLowerBound() * (0.5 + 0.5 * rng.uniform()));
+    }
+    sums.setDueDates(dueDates);
+    InsertionSearch sumInsertion(sums);
+    for (Objective objective : {Objective::Flowtime, Objective::Tardiness}) {
+        sums.setObjective(objective);
+        std::string name = objectiveName(objective);
+        bench.run(name, problem, [&] {
+            sink = sink + sums.evaluate(permutation.data());
+        });
+        bench.run("insert_all_" + name, problem, [&] {
+            sumInsertion.insertionValues(removed, permutation.back(), makespans);
+            sink = sink + makespans[0];
+        });
+        bench.run("best_insert_" + name, problem, [&] {
+            int position;
+            sink = sink + sumInsertion.bestInsertion(removed, permutation.back(), position);
+        });
+    }
+
+    Constructive constructive(problem);
+    bench.run("neh", problem, [&] {
+        sink = sink + static_cast<long long>(constructive.nehAlgorithm().size());
+    });
+}
+
+// One iteration (generation, sweep, temperature step) of every solver,
+// including its start from the cached NEH solution
+void benchSolvers(Bench& bench, const Problem& problem, long seed) {
+    Termination termination;
+    termination.stopAtLowerBound = false;
+
+    auto iterate = [&](Metaheuristic& solver) {
+        solver.setTermination(termination);
+        solver.setSeed(static_cast<uint64_t>(seed));
+        sink = sink + solver.solve().getMakespan();
+    };
+
+    bench.run("iter_ls", problem, [&] {
+        LocalSearch solver(problem, 1);
+        iterate(solver);
+    });
+    // Its first descent from NEH costs far more than an iteration, so it
+    // runs once outside the timing
+    IteratedLocalSearch ils(problem, 0, 3);
+    Solution localOptimum(problem);
+    if (bench.enabled("iter_ils")) {
+        iterate(ils);
+        localOptimum = ils.getBestSolution();
+    }
+    bench.run("iter_ils", problem, [&] {
+        ils.iterate(localOptimum);
+        sink = sink + localOptimum.getMakespan();
+    });
+    bench.run("iter_sa", problem, [&] {
+        SimulatedAnnealing solver(problem, 1, 1000.0, 0.95);
+        iterate(solver);
+    });
+    bench.run("iter_ts", problem, [&] {
+        TabuSearch solver(problem, 1, 10);
+        iterate(solver);
+    });
+    bench.run("iter_ga", problem, [&] {
+        GeneticAlgorithm solver(problem, 50, 1, 0.1);
+        iterate(solver);
+    });
+    bench.run("iter_aco", problem, [&] {
+        AntColony solver(problem, 20, 1, 0.1, 1.0, 2.0);
+        iterate(solver);
+    });
+    bench.run("iter_ig", problem, [&] {
+        IteratedGreedy solver(problem, 1, 4, 0.4);
+        iterate(solver);
+    });
+}
+
+void writeJson(std::ostream& out, const std::vector<Result>& results) {
+    // One benchmark per line, which readBaseline relies on
+    out << "{\n  \"benchmarks\": [\n";
+    for (size_t k = 0; k < results.size(); ++k) {
+        const Result& r = results[k];
+        out << "    {\"name\": \"" << r.name << "\", \"n\": " << r.jobs << ", \"m\": " << r.machines
+            << ", \"reps\": " << r.reps << ", \"batch\": " << r.batch
+            << std::fixed << std::setprecision(2)
+            << ", \"median_ns\": " << r.medianNs << ", \"p95_ns\": " << r.p95Ns
+            << ", \"min_ns\": " << r.minNs << "}" << (k + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// Value following "key": on a line written by writeJson
+std::string jsonField(const std::string& line, const std::string& key) {
+    std::string pattern = "\"" + key + "\": ";
+    size_t start = line.find(pattern);
+    if (start == std::string::npos) {
+        return "";
+    }
+    start += pattern.size();
+    if (line[start] == '"') {
+        return line.substr(start + 1, line.find('"', start + 1) - start - 1);
+    }
+    return line.substr(start, line.find_first_of(",}", start) - start);
+}
+
+std::vector<Result> readBaseline(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open baseline: " + filename);
+    }
+    std::vector<Result> results;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (jsonField(line, "name").empty()) {
+            continue;
+        }
+        Result r{};
+        r.name = jsonField(line, "name");
+        r.jobs = std::stoi(jsonField(line, "n"));
+        r.machines = std::stoi(jsonField(line, "m"));
+        r.medianNs = std::stod(jsonField(line, "median_ns"));
+        results.push_back(r);
+    }
+    return results;
+}
+
+// Prints the benchmarks whose median moved by more than the tolerance;
+// returns the number of regressions
+int compareWithBaseline(const std::vector<Result>& results, const std::vector<Result>& baseline, double tolerance) {
+    int regressions = 0;
+    std::cerr << "\nComparison with baseline (tolerance " << std::setprecision(0)
+              << 100.0 * tolerance << "%):" << std::endl;
+    for (const Result& r : results) {
+        auto old = std::find_if(baseline.begin(), baseline.end(), [&](const Result& b) {
+            return b.name == r.name && b.jobs == r.jobs && b.machines == r.machines;
+        });
+        if (old == baseline.end() || old->medianNs <= 0.0) {
+            continue;
+        }
+        double change = r.medianNs / old->medianNs - 1.0;
+        if (std::abs(change) <= tolerance) {
+            continue;
+        }
+        bool slower = change > 0.0;
+        regressions += slower ? 1 : 0;
+        std::cerr << "  " << (slower ? "REGRESSION " : "improvement ") << std::left << std::setw(22) << r.name
+                  << std::right << std::setw(6) << r.jobs << "x" << std::left << std::setw(4) << r.machines
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(14) << old->medianNs
+                  << " -> " << std::setw(14) << r.medianNs << " ns (" << std::showpos << 100.0 * change
+                  << std::noshowpos << "%)" << std::endl;
+    }
+    std::cerr << "  " << regressions << " regression(s)" << std::endl;
+    return regressions;
+}
+
+std::vector<std::string> splitList(const std::string& str) {
+    std::vector<std::string> items;
+    std::istringstream iss(str);
+    std::string token;
+    while (std::getline(iss, token, ',')) {
+        if (!token.empty()) {
+            items.push_back(token);
+        }
+    }
+    return items;
+}
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --sizes=20x5,100x20      Instance sizes (jobs x machines), default n in {20..1000}, m in {5..50}" << std::endl;
+    std::cout << "  --filter=makespan,iter_  Only benchmarks whose name starts with one of these" << std::endl;
+    std::cout << "  --reps=15                Timed samples per benchmark" << std::endl;
+    std::cout << "  --warmup=2               Untimed samples per benchmark" << std::endl;
+    std::cout << "  --max-time=1.0           Stop sampling a benchmark after this many seconds (at least 3 samples)" << std::endl;
+    std::cout << "  --seed=873654221         Seed of the instance generator" << std::endl;
+    std::cout << "  --out=bench.json         Write the JSON results to a file instead of stdout" << std::endl;
+    std::cout << "  --baseline=bench.json    Compare medians with a previous run, exit 1 on regressions" << std::endl;
+    std::cout << "  --tolerance=0.10         Relative slowdown reported as a regression" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.find("--sizes=") == 0) {
+            for (const auto& size : splitList(arg.substr(8))) {
+                size_t x = size.find('x');
+                if (x == std::string::npos) {
+                    std::cerr << "Invalid size: " << size << std::endl;
+                    return 1;
+                }
+                options.sizes.push_back({std::stoi(size.substr(0, x)), std::stoi(size.substr(x + 1))});
+            }
+        } else if (arg.find("--filter=") == 0) {
+            options.filters = splitList(arg.substr(9));
+        } else if (arg.find("--reps=") == 0) {
+            options.reps = std::max(1, std::stoi(arg.substr(7)));
+        } else if (arg.find("--warmup=") == 0) {
+            options.warmup = std::max(0, std::stoi(arg.substr(9)));
+        } else if (arg.find("--max-time=") == 0) {
+            options.maxSeconds = std::stod(arg.substr(11));
+        } else if (arg.find("--seed=") == 0) {
+            options.seed = std::stol(arg.substr(7));
+        } else if (arg.find("--out=") == 0) {
+            options.outputFile = arg.substr(6);
+        } else if (arg.find("--baseline=") == 0) {
+            options.baselineFile = arg.substr(11);
+        } else if (arg.find("--tolerance=") == 0) {
+            options.tolerance = std::stod(arg.substr(12));
+        } else if (arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (options.sizes.empty()) {
+        for (int jobs : {20, 50, 100, 200, 500, 1000}) {
+            for (int machines : {5, 10, 20, 50}) {
+                options.sizes.push_back({jobs, machines});
+            }
+        }
+    }
+
+    try {
+        Bench bench(options);
+        for (auto [jobs, machines] : options.sizes) {
+            Problem problem(taillardTimes(jobs, machines, options.seed));
+            Rng rng(static_cast<uint64_t>(options.seed));
+            benchKernels(bench, problem, rng);
+            benchSolvers(bench, problem, options.seed);
+        }
+
+        if (options.outputFile.empty()) {
+            writeJson(std::cout, bench.getResults());
+        } else {
+            std::ofstream out(options.outputFile);
+            if (!out.is_open()) {
+                throw std::runtime_error("Cannot write " + options.outputFile);
+            }
+            writeJson(out, bench.getResults());
+        }
+
+        if (!options.baselineFile.empty()) {
+            auto baseline = readBaseline(options.baselineFile);
+            if (compareWithBaseline(bench.getResults(), baseline, options.tolerance) > 0) {
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,196 @@
+#include "pfsp.h"
+#include "problem.hpp"
+#include "solver_factory.hpp"
+#include <algorithm>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct pfsp_problem {
+    std::vector<int> copiedTimes;  // Only for the machine-major layout
+    std::unique_ptr<Problem> problem;
+};
+
+namespace {
+
+thread_local std::string lastError;
+
+pfsp_status fail(pfsp_status status, const std::string& message) {
+    lastError = message;
+    return status;
+}
+
+// Turns exceptions into status codes; nothing may escape to C callers
+template <typename Body>
+pfsp_status guarded(Body body) {
+    try {
+        lastError.clear();
+        return body();
+    } catch (const std::invalid_argument& e) {
+        return fail(PFSP_INVALID_ARGUMENT, e.what());
+    } catch (const std::out_of_range& e) {
+        return fail(PFSP_INVALID_ARGUMENT, e.what());
+    } catch (const std::runtime_error& e) {
+        return fail(PFSP_INVALID_ARGUMENT, e.what());
+    } catch (const std::bad_alloc&) {
+        return fail(PFSP_INTERNAL, "Out of memory");
+    } catch (const std::exception& e) {
+        return fail(PFSP_INTERNAL, e.what());
+    } catch (...) {
+        return fail(PFSP_INTERNAL, "Unknown error");
+    }
+}
+
+bool isSolver(const std::string& name) {
+    for (const std::string& known : solverNames()) {
+        if (known == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+extern "C" {
+
+int pfsp_api_version(void) {
+    return PFSP_API_VERSION;
+}
+
+const char* pfsp_last_error(void) {
+    return lastError.c_str();
+}
+
+pfsp_status pfsp_problem_create(int jobs, int machines, const int* times, pfsp_layout layout,
+                                pfsp_problem** out) {
+    return guarded([&] {
+        if (out == nullptr || times == nullptr) {
+            return fail(PFSP_INVALID_ARGUMENT, "Null pointer argument");
+        }
+        *out = nullptr;
+        if (jobs <= 0 || machines <= 0) {
+            return fail(PFSP_INVALID_ARGUMENT, "Invalid problem size");
+        }
+
+        auto handle = std::make_unique<pfsp_problem>();
+        const int* jobMajorTimes = times;
+        if (layout == PFSP_LAYOUT_MACHINE_MAJOR) {
+            handle->copiedTimes.resize(static_cast<size_t>(jobs) * machines);
+            for (int i = 0; i < machines; ++i) {
+                for (int j = 0; j < jobs; ++j) {
+                    handle->copiedTimes[j * machines + i] = times[i * jobs + j];
+                }
+            }
+            jobMajorTimes = handle->copiedTimes.data();
+        } else if (layout != PFSP_LAYOUT_JOB_MAJOR) {
+            return fail(PFSP_INVALID_ARGUMENT, "Unknown layout");
+        }
+        handle->problem = std::make_unique<Problem>(jobs, machines, jobMajorTimes);
+        *out = handle.release();
+        return PFSP_OK;
+    });
+}
+
+pfsp_status pfsp_problem_load(const char* filename, pfsp_problem** out) {
+    return guarded([&] {
+        if (out == nullptr || filename == nullptr) {
+            return fail(PFSP_INVALID_ARGUMENT, "Null pointer argument");
+        }
+        *out = nullptr;
+        auto handle = std::make_unique<pfsp_problem>();
+        handle->problem = std::make_unique<Problem>(std::string(filename));
+        *out = handle.release();
+        return PFSP_OK;
+    });
+}
+
+void pfsp_problem_destroy(pfsp_problem* problem) {
+    delete problem;
+}
+
+int pfsp_problem_jobs(const pfsp_problem* problem) {
+    return problem ? problem->problem->getNumJobs() : 0;
+}
+
+int pfsp_problem_machines(const pfsp_problem* problem) {
+    return problem ? problem->problem->getNumMachines() : 0;
+}
+
+int pfsp_problem_lower_bound(const pfsp_problem* problem) {
+    return problem ? problem->problem->getLowerBound() : 0;
+}
+
+void pfsp_options_init(pfsp_options* options) {
+    if (options == nullptr) {
+        return;
+    }
+    options->time_limit = 0.0;
+    options->max_evaluations = 0;
+    options->seed = 0;
+    options->ignore_iteration_limits = 0;
+    options->params = nullptr;
+}
+
+pfsp_status pfsp_solve(const pfsp_problem* problem, const char* solver, const pfsp_options* options,
+                       int* permutation, pfsp_stats* stats) {
+    return guarded([&] {
+        if (problem == nullptr || solver == nullptr || permutation == nullptr) {
+            return fail(PFSP_INVALID_ARGUMENT, "Null pointer argument");
+        }
+        if (!isSolver(solver)) {
+            return fail(PFSP_UNKNOWN_SOLVER, std::string("Unknown solver: ") + solver);
+        }
+        pfsp_options defaults;
+        pfsp_options_init(&defaults);
+        const pfsp_options& opts = options ? *options : defaults;
+        if (opts.time_limit < 0.0 || opts.max_evaluations < 0) {
+            return fail(PFSP_INVALID_ARGUMENT, "Negative budget");
+        }
+
+        std::unique_ptr<Metaheuristic> metaheuristic =
+            createSolver(solver, *problem->problem, parseSolverParams(opts.params ? opts.params : ""));
+        Termination termination;
+        termination.timeLimit = opts.time_limit;
+        termination.maxEvaluations = opts.max_evaluations;
+        termination.ignoreIterationLimits = opts.ignore_iteration_limits != 0;
+        metaheuristic->setTermination(termination);
+        metaheuristic->setSeed(opts.seed != 0 ? opts.seed : Rng::randomSeed());
+
+        Solution best = metaheuristic->solve();
+        const std::vector<int>& order = best.getPermutation();
+        std::copy(order.begin(), order.end(), permutation);
+
+        if (stats != nullptr) {
+            stats->makespan = best.getMakespan();
+            stats->lower_bound = problem->problem->getLowerBound();
+            stats->time = metaheuristic->getExecutionTime();
+            stats->setup_time = metaheuristic->getSetupTime();
+            stats->evaluations = metaheuristic->getEvaluations();
+            stats->seed = metaheuristic->getSeed();
+        }
+        return PFSP_OK;
+    });
+}
+
+pfsp_status pfsp_evaluate(const pfsp_problem* problem, const int* permutation, int* makespan) {
+    return guarded([&] {
+        if (problem == nullptr || permutation == nullptr || makespan == nullptr) {
+            return fail(PFSP_INVALID_ARGUMENT, "Null pointer argument");
+        }
+        int jobs = problem->problem->getNumJobs();
+        std::vector<bool> seen(jobs, false);
+        for (int i = 0; i < jobs; ++i) {
+            if (permutation[i] < 0 || permutation[i] >= jobs || seen[permutation[i]]) {
+                return fail(PFSP_INVALID_ARGUMENT, "Not a permutation of the jobs");
+            }
+            seen[permutation[i]] = true;
+        }
+        *makespan = problem->problem->calculateMakespan(permutation);
+        return PFSP_OK;
+    });
+}
+
+} // extern "C"
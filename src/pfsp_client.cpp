@@ -0,0 +1,74 @@
+// Small client for pfsp --serve=SOCKET: sends the requests given as
+// arguments (or read from stdin, one per line) and prints every reply until
+// the server has answered them all.
+//
+//   ./pfsp_client /tmp/pfsp.sock "solve id=1 instance=data/20_5_1.txt solver=ig time-limit=0.2"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+int main(int argc, char* argv[]) {
+    if (argc < 2 || std::string(argv[1]) == "--help") {
+        std::cout << "Usage: " << argv[0] << " <socket> [request ...]" << std::endl;
+        std::cout << "Without requests on the command line, they are read from stdin." << std::endl;
+        return argc < 2 ? 1 : 0;
+    }
+
+    std::string path = argv[1];
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: Socket path too long" << std::endl;
+        return 1;
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        std::cerr << "Error: Cannot connect to " << path << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> requests(argv + 2, argv + argc);
+    if (requests.empty()) {
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            requests.push_back(line);
+        }
+    }
+    for (const std::string& request : requests) {
+        std::string data = request + "\n";
+        if (::send(fd, data.data(), data.size(), 0) != static_cast<ssize_t>(data.size())) {
+            std::cerr << "Error: Cannot send request" << std::endl;
+            return 1;
+        }
+    }
+
+    // The server closes the connection once every request is answered
+    ::shutdown(fd, SHUT_WR);
+    char chunk[4096];
+    ssize_t count;
+    while ((count = ::recv(fd, chunk, sizeof(chunk), 0)) > 0) {
+        std::cout.write(chunk, count);
+    }
+    std::cout.flush();
+    ::close(fd);
+    return 0;
+}
+
+#else
+
+int main() {
+    std::cerr << "Error: Unix sockets are not available on this platform; pipe requests into pfsp --serve" << std::endl;
+    return 1;
+}
+
+#endif
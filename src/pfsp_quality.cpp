@@ -0,0 +1,371 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "problem.hpp"
+#include "local_search.hpp"
+#include "iterated_local_search.hpp"
+#include "simulated_annealing.hpp"
+#include "tabu_search.hpp"
+#include "genetic_algorithm.hpp"
+#include "ant_colony.hpp"
+#include "iterated_greedy.hpp"
+
+// Solution quality versus time: every solver runs on every instance under
+// the same time budget with several seeds. Results are reported as the
+// average relative percentage deviation (ARPD) from the best known makespan,
+// plus the time each run needed to get within given percentages of it.
+
+namespace {
+
+namespace fs = std::filesystem;
+
+struct Options {
+    std::vector<std::string> instances;
+    std::string referenceFile = "data/best_known.csv";
+    std::vector<std::string> solvers = {"ls", "ils", "sa", "ts", "ga", "aco", "ig"};
+    int seeds = 5;
+    double timeLimit = 1.0;   // Seconds per run
+    double rho = 0.0;         // If set, n * (m / 2) * rho milliseconds per run
+    std::vector<double> targets = {0.0, 0.5, 1.0, 2.0, 5.0};  // Percent above the reference
+    std::string outputFile = "quality.json";
+};
+
+struct Instance {
+    std::string name;
+    std::unique_ptr<Problem> problem;
+    int reference;  // Best known makespan
+};
+
+struct Run {
+    const Instance* instance;
+    std::string solver;
+    int seed;
+    double budget;
+    int makespan;
+    double rpd;
+    double time;
+    long long evaluations;
+    std::vector<std::pair<double, int>> trace;  // (seconds, makespan) of each new best
+    std::vector<double> timeToTarget;           // Per target, negative if never reached
+};
+
+const std::map<std::string, std::pair<std::string, std::function<std::unique_ptr<Metaheuristic>(const Problem&)>>> solverTable = {
+    {"ls",  {"Local Search",              [](const Problem& p) { return std::make_unique<LocalSearch>(p); }}},
+    {"ils", {"Iterated Local Search",     [](const Problem& p) { return std::make_unique<IteratedLocalSearch>(p); }}},
+    {"sa",  {"Simulated Annealing",       [](const Problem& p) { return std::make_unique<SimulatedAnnealing>(p); }}},
+    {"ts",  {"Tabu Search",               [](const Problem& p) { return std::make_unique<TabuSearch>(p); }}},
+    {"ga",  {"Genetic Algorithm",         [](const Problem& p) { return std::make_unique<GeneticAlgorithm>(p); }}},
+    {"aco", {"Ant Colony Optimization",   [](const Problem& p) { return std::make_unique<AntColony>(p); }}},
+    {"ig",  {"Iterated Greedy",           [](const Problem& p) { return std::make_unique<IteratedGreedy>(p); }}},
+};
+
+std::vector<std::string> splitList(const std::string& str) {
+    std::vector<std::string> items;
+    std::istringstream iss(str);
+    std::string token;
+    while (std::getline(iss, token, ',')) {
+        if (!token.empty()) {
+            items.push_back(token);
+        }
+    }
+    return items;
+}
+
+// "instance,makespan" lines, instance being the file name without extension
+std::map<std::string, int> readReference(const std::string& filename) {
+    std::map<std::string, int> reference;
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        return reference;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        // Comments, the header line and anything else without a number
+        size_t comma = line.find(',');
+        if (line.empty() || line[0] == '#' || comma == std::string::npos ||
+            !std::isdigit(static_cast<unsigned char>(line[comma + 1]))) {
+            continue;
+        }
+        reference[line.substr(0, comma)] = std::stoi(line.substr(comma + 1));
+    }
+    return reference;
+}
+
+std::vector<std::string> listInstances(const std::string& path) {
+    if (!fs::is_directory(path)) {
+        return {path};
+    }
+    std::vector<std::string> files;
+    for (const auto& entry : fs::directory_iterator(path)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+            files.push_back(entry.path().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+Run runSolver(const Instance& instance, const std::string& solver, int seed, double budget,
+              const std::vector<double>& targets) {
+    const Problem& problem = *instance.problem;
+    Run run{&instance, solver, seed, budget, 0, 0.0, 0.0, 0, {}, {}};
+
+    Termination termination;
+    termination.timeLimit = budget;
+    termination.ignoreIterationLimits = true;
+
+    auto metaheuristic = solverTable.at(solver).second(problem);
+    metaheuristic->setTermination(termination);
+    metaheuristic->setSeed(static_cast<uint64_t>(seed));
+    auto trace = std::make_shared<ConvergenceTrace>(1 << 16);
+    metaheuristic->setConvergenceTrace(trace);
+    Solution best = metaheuristic->solve();
+    for (const auto& point : trace->snapshot()) {
+        run.trace.push_back({point.time, point.makespan});
+    }
+
+    run.makespan = best.getMakespan();
+    run.rpd = 100.0 * (run.makespan - instance.reference) / instance.reference;
+    run.time = metaheuristic->getExecutionTime();
+    run.evaluations = metaheuristic->getEvaluations();
+    for (double target : targets) {
+        int goal = static_cast<int>(instance.reference * (1.0 + target / 100.0));
+        auto hit = std::find_if(run.trace.begin(), run.trace.end(),
+                                [goal](const std::pair<double, int>& point) { return point.second <= goal; });
+        run.timeToTarget.push_back(hit == run.trace.end() ? -1.0 : hit->first);
+    }
+    return run;
+}
+
+void writeJson(const std::string& filename, const Options& options, const std::vector<Run>& runs) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        throw std::runtime_error("Cannot write " + filename);
+    }
+    out << "{\n  \"targets\": [";
+    for (size_t t = 0; t < options.targets.size(); ++t) {
+        out << (t ? ", " : "") << options.targets[t];
+    }
+    out << "],\n  \"runs\": [\n";
+    for (size_t k = 0; k < runs.size(); ++k) {
+        const Run& run = runs[k];
+        const Problem& problem = *run.instance->problem;
+        out << "    {\"instance\": \"" << run.instance->name << "\", \"n\": " << problem.getNumJobs()
+            << ", \"m\": " << problem.getNumMachines() << ", \"reference\": " << run.instance->reference
+            << ", \"solver\": \"" << run.solver << "\", \"seed\": " << run.seed
+            << std::fixed << std::setprecision(6) << ", \"budget\": " << run.budget
+            << ", \"makespan\": " << run.makespan << ", \"rpd\": " << run.rpd
+            << ", \"time\": " << run.time << ", \"evaluations\": " << run.evaluations << ", \"trace\": [";
+        for (size_t p = 0; p < run.trace.size(); ++p) {
+            out << (p ? ", " : "") << "[" << run.trace[p].first << ", " << run.trace[p].second << "]";
+        }
+        out << "], \"time_to_target\": [";
+        for (size_t t = 0; t < run.timeToTarget.size(); ++t) {
+            out << (t ? ", " : "");
+            if (run.timeToTarget[t] < 0.0) {
+                out << "null";
+            } else {
+                out << run.timeToTarget[t];
+            }
+        }
+        out << "]}" << (k + 1 < runs.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// ARPD per solver and instance class (n x m), then the share of runs that
+// reached each target and their median time to get there
+void printSummary(const Options& options, const std::vector<Run>& runs) {
+    std::vector<std::string> classes;
+    for (const Run& run : runs) {
+        const Problem& problem = *run.instance->problem;
+        std::string name = std::to_string(problem.getNumJobs()) + "x" + std::to_string(problem.getNumMachines());
+        if (std::find(classes.begin(), classes.end(), name) == classes.end()) {
+            classes.push_back(name);
+        }
+    }
+    auto classOf = [](const Run& run) {
+        const Problem& problem = *run.instance->problem;
+        return std::to_string(problem.getNumJobs()) + "x" + std::to_string(problem.getNumMachines());
+    };
+
+    std::cout << "\nARPD (%) from the best known makespans" << std::endl;
+    std::cout << std::left << std::setw(26) << "Solver" << std::right;
+    for (const auto& name : classes) {
+        std::cout << std::setw(10) << name;
+    }
+    std::cout << std::setw(10) << "All" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (const auto& solver : options.solvers) {
+        std::cout << std::left << std::setw(26) << solverTable.at(solver).first << std::right;
+        double total = 0.0;
+        int count = 0;
+        for (const auto& name : classes) {
+            double sum = 0.0;
+            int runsInClass = 0;
+            for (const Run& run : runs) {
+                if (run.solver == solver && classOf(run) == name) {
+                    sum += run.rpd;
+                    runsInClass++;
+                }
+            }
+            total += sum;
+            count += runsInClass;
+            std::cout << std::setw(10) << (runsInClass ? sum / runsInClass : 0.0);
+        }
+        std::cout << std::setw(10) << (count ? total / count : 0.0) << std::endl;
+    }
+
+    std::cout << "\nTime to target: runs within the target / median seconds among them" << std::endl;
+    std::cout << std::left << std::setw(26) << "Solver" << std::right;
+    for (double target : options.targets) {
+        std::ostringstream label;
+        label << "+" << std::setprecision(1) << std::fixed << target << "%";
+        std::cout << std::setw(18) << label.str();
+    }
+    std::cout << std::endl;
+    for (const auto& solver : options.solvers) {
+        std::cout << std::left << std::setw(26) << solverTable.at(solver).first << std::right;
+        for (size_t t = 0; t < options.targets.size(); ++t) {
+            std::vector<double> times;
+            int total = 0;
+            for (const Run& run : runs) {
+                if (run.solver == solver) {
+                    total++;
+                    if (run.timeToTarget[t] >= 0.0) {
+                        times.push_back(run.timeToTarget[t]);
+                    }
+                }
+            }
+            std::ostringstream cell;
+            cell << times.size() << "/" << total;
+            if (!times.empty()) {
+                std::sort(times.begin(), times.end());
+                cell << " " << std::fixed << std::setprecision(3) << times[times.size() / 2] << "s";
+            }
+            std::cout << std::setw(18) << cell.str();
+        }
+        std::cout << std::endl;
+    }
+}
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options] [instance files or directories]" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --reference=data/best_known.csv  Best known makespans as instance,makespan lines" << std::endl;
+    std::cout << "  --solvers=ls,ils,sa,ts,ga,aco,ig Solvers to compare" << std::endl;
+    std::cout << "  --seeds=5                        Runs per solver and instance, seeds 1..N" << std::endl;
+    std::cout << "  --time=1.0                       Seconds per run" << std::endl;
+    std::cout << "  --rho=30                         n * (m / 2) * rho milliseconds per run instead" << std::endl;
+    std::cout << "  --targets=0,0.5,1,2,5            Percentages above the reference for time to target" << std::endl;
+    std::cout << "  --out=quality.json               Raw results" << std::endl;
+    std::cout << "Without instances, every .txt file in data/ is used." << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.find("--reference=") == 0) {
+            options.referenceFile = arg.substr(12);
+        } else if (arg.find("--solvers=") == 0) {
+            options.solvers = splitList(arg.substr(10));
+        } else if (arg.find("--seeds=") == 0) {
+            options.seeds = std::max(1, std::stoi(arg.substr(8)));
+        } else if (arg.find("--time=") == 0) {
+            options.timeLimit = std::stod(arg.substr(7));
+        } else if (arg.find("--rho=") == 0) {
+            options.rho = std::stod(arg.substr(6));
+        } else if (arg.find("--targets=") == 0) {
+            options.targets.clear();
+            for (const auto& target : splitList(arg.substr(10))) {
+                options.targets.push_back(std::stod(target));
+            }
+        } else if (arg.find("--out=") == 0) {
+            options.outputFile = arg.substr(6);
+        } else if (arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg.find("--") == 0) {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            options.instances.push_back(arg);
+        }
+    }
+    if (options.instances.empty()) {
+        options.instances.push_back("data");
+    }
+    for (const auto& solver : options.solvers) {
+        if (solverTable.find(solver) == solverTable.end()) {
+            std::cerr << "Unknown solver: " << solver << std::endl;
+            return 1;
+        }
+    }
+
+    try {
+        // Best known values from the instance header take precedence over
+        // the reference file; without either, the lower bound is used
+        auto reference = readReference(options.referenceFile);
+        std::vector<Instance> instances;
+        for (const auto& path : options.instances) {
+            for (const auto& file : listInstances(path)) {
+                Instance instance;
+                instance.name = fs::path(file).stem().string();
+                instance.problem = std::make_unique<Problem>(file);
+                instance.reference = instance.problem->getKnownUpperBound();
+                if (instance.reference <= 0 && reference.count(instance.name)) {
+                    instance.reference = reference[instance.name];
+                }
+                if (instance.reference <= 0) {
+                    std::cerr << "Warning: no best known makespan for " << instance.name
+                              << ", using its lower bound" << std::endl;
+                    instance.reference = instance.problem->getLowerBound();
+                }
+                instances.push_back(std::move(instance));
+            }
+        }
+
+        std::vector<Run> runs;
+        for (const auto& instance : instances) {
+            const Problem& problem = *instance.problem;
+            double budget = options.rho > 0.0
+                ? problem.getNumJobs() * (problem.getNumMachines() / 2.0) * options.rho / 1000.0
+                : options.timeLimit;
+            std::cout << instance.name << " (" << problem.getNumJobs() << "x" << problem.getNumMachines()
+                      << ", reference " << instance.reference << ", " << budget << " s per run)" << std::endl;
+            for (const auto& solver : options.solvers) {
+                std::cout << "  " << std::left << std::setw(26) << solverTable.at(solver).first << std::right;
+                for (int seed = 1; seed <= options.seeds; ++seed) {
+                    runs.push_back(runSolver(instance, solver, seed, budget, options.targets));
+                    std::cout << " " << runs.back().makespan << std::flush;
+                }
+                std::cout << std::endl;
+            }
+        }
+
+        printSummary(options, runs);
+        writeJson(options.outputFile, options, runs);
+        std::cout << "\nRaw results written to " << options.outputFile << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
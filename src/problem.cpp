@@ -1,10 +1,42 @@
 #include "problem.hpp"
+#include "objective.hpp"
 #include <sstream>
 #include <algorithm>
 #include <iostream>
+#include <limits>
 
-Problem::Problem(const std::string& filename) {
+Problem::Problem(const std::string& filename)
+    : lowerBound(0), knownUpperBound(0), objective(Objective::Makespan), objectiveLowerBound(0) {
     loadFromFile(filename);
+    initialize();
+}
+
+Problem::Problem(const std::vector<std::vector<int>>& processingTimes)
+    : numMachines(static_cast<int>(processingTimes.size())),
+      numJobs(processingTimes.empty() ? 0 : static_cast<int>(processingTimes[0].size())),
+      lowerBound(0), knownUpperBound(0), objective(Objective::Makespan), objectiveLowerBound(0) {
+    for (const auto& row : processingTimes) {
+        if (row.size() != static_cast<size_t>(numJobs)) {
+            throw std::runtime_error("Processing time rows differ in length");
+        }
+    }
+    ownedTimes.resize(static_cast<size_t>(numJobs) * numMachines);
+    for (int i = 0; i < numMachines; ++i) {
+        for (int j = 0; j < numJobs; ++j) {
+            ownedTimes[j * numMachines + i] = processingTimes[i][j];
+        }
+    }
+    jobMajorTimes = ownedTimes.data();
+    initialize();
+}
+
+Problem::Problem(int numJobs, int numMachines, const int* jobMajorTimes)
+    : numMachines(numMachines), numJobs(numJobs), jobMajorTimes(jobMajorTimes),
+      lowerBound(0), knownUpperBound(0), objective(Objective::Makespan), objectiveLowerBound(0) {
+    if (jobMajorTimes == nullptr) {
+        throw std::runtime_error("Missing processing times");
+    }
+    initialize();
 }
 
 void Problem::loadFromFile(const std::string& filename) {
@@ -14,24 +46,32 @@ void Problem::loadFromFile(const std::string& filename) {
     }
 
     std::string line;
-    std::vector<std::vector<int>> tempMatrix;
     
-    // Read first line to get number of jobs and machines
+    // Read first line to get number of jobs and machines. Taillard's
+    // headers go on with the generator seed, the best known makespan and a
+    // lower bound, which are kept if present.
     std::getline(file, line);
     std::istringstream iss(line);
     iss >> numJobs >> numMachines;
+    long long seed;
+    int upper, lower;
+    if (iss >> seed >> upper >> lower) {
+        knownUpperBound = upper;
+        lowerBound = lower;
+    }
+    if (numJobs <= 0 || numMachines <= 0) {
+        throw std::runtime_error("Invalid problem size in input file");
+    }
     
-    // Initialize processing times matrix
-    processingTimes.resize(numMachines, std::vector<int>(numJobs));
-    
-    // Read processing times
+    // The file lists one machine per line; times are stored job by job
+    ownedTimes.resize(static_cast<size_t>(numJobs) * numMachines);
     for (int i = 0; i < numMachines; ++i) {
         if (!std::getline(file, line)) {
             throw std::runtime_error("Not enough lines in input file");
         }
         std::istringstream iss(line);
         for (int j = 0; j < numJobs; ++j) {
-            if (!(iss >> processingTimes[i][j])) {
+            if (!(iss >> ownedTimes[j * numMachines + i])) {
                 throw std::runtime_error("Not enough values in line " + std::to_string(i + 2));
             }
         }
@@ -45,25 +85,232 @@ void Problem::loadFromFile(const std::string& filename) {
     if (std::getline(file, extraLine)) {
         throw std::runtime_error("Too many lines in input file");
     }
+    jobMajorTimes = ownedTimes.data();
 }
 
-int Problem::calculateMakespan(const std::vector<int>& permutation) const {
-    if (permutation.size() != numJobs) {
-        throw std::runtime_error("Invalid permutation size");
+void Problem::initialize() {
+    if (numJobs <= 0 || numMachines <= 0) {
+        throw std::runtime_error("Empty processing time matrix");
+    }
+    size_t size = static_cast<size_t>(numJobs) * numMachines;
+    if (std::any_of(jobMajorTimes, jobMajorTimes + size, [](int time) { return time < 0; })) {
+        throw std::runtime_error("Negative processing time");
     }
+    
+    lastMachineWork = 0;
+    for (int j = 0; j < numJobs; ++j) {
+        lastMachineWork += getJobTimes(j)[numMachines - 1];
+    }
+    computeLowerBound();
+}
 
-    // Initialize completion times matrix
-    std::vector<std::vector<int>> completionTimes(numMachines, std::vector<int>(numJobs, 0));
+void Problem::computeLowerBound() {
+    // Job-based: no job finishes before its total processing time
+    int jobBound = 0;
+    for (int j = 0; j < numJobs; ++j) {
+        const int* times = getJobTimes(j);
+        int total = 0;
+        for (int i = 0; i < numMachines; ++i) {
+            total += times[i];
+        }
+        jobBound = std::max(jobBound, total);
+    }
     
-    // Calculate completion times
+    // Machine-based: machine i is idle at least until the shortest head
+    // before it, processes all its work, and some job still needs the
+    // shortest tail after it
+    int machineBound = 0;
     for (int i = 0; i < numMachines; ++i) {
+        int minHead = std::numeric_limits<int>::max();
+        int minTail = std::numeric_limits<int>::max();
+        int work = 0;
         for (int j = 0; j < numJobs; ++j) {
-            int job = permutation[j];
-            int prevMachineTime = (i > 0) ? completionTimes[i-1][j] : 0;
-            int prevJobTime = (j > 0) ? completionTimes[i][j-1] : 0;
-            completionTimes[i][j] = std::max(prevMachineTime, prevJobTime) + processingTimes[i][job];
+            const int* times = getJobTimes(j);
+            int head = 0;
+            int tail = 0;
+            for (int k = 0; k < i; ++k) head += times[k];
+            for (int k = i + 1; k < numMachines; ++k) tail += times[k];
+            minHead = std::min(minHead, head);
+            minTail = std::min(minTail, tail);
+            work += times[i];
+        }
+        machineBound = std::max(machineBound, minHead + work + minTail);
+    }
+    
+    lowerBound = std::max({lowerBound, jobBound, machineBound});
+}
+
+void Problem::setObjective(Objective newObjective) {
+    if (newObjective == Objective::Tardiness && dueDates.empty()) {
+        throw std::invalid_argument("Total tardiness needs due dates");
+    }
+    objective = newObjective;
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        permutationCache.clear();
+    }
+    
+    objectiveLowerBound = 0;
+    if (objective == Objective::Flowtime) {
+        // Every job takes at least its total processing time, and the r-th
+        // job to leave the last machine cannot do so before the shortest
+        // head plus the r shortest times on that machine
+        long long totalWork = 0;
+        int minHead = std::numeric_limits<int>::max();
+        std::vector<int> lastTimes(numJobs);
+        for (int j = 0; j < numJobs; ++j) {
+            const int* times = getJobTimes(j);
+            int head = 0;
+            for (int i = 0; i + 1 < numMachines; ++i) {
+                head += times[i];
+            }
+            minHead = std::min(minHead, head);
+            lastTimes[j] = times[numMachines - 1];
+            totalWork += head + lastTimes[j];
+        }
+        std::sort(lastTimes.begin(), lastTimes.end());
+        long long machineBound = 0;
+        long long finish = minHead;
+        for (int time : lastTimes) {
+            finish += time;
+            machineBound += finish;
+        }
+        objectiveLowerBound = static_cast<int>(std::min<long long>(std::max(totalWork, machineBound),
+                                                                   std::numeric_limits<int>::max()));
+    } else if (objective == Objective::Tardiness) {
+        // No job finishes before its total processing time
+        long long bound = 0;
+        for (int j = 0; j < numJobs; ++j) {
+            const int* times = getJobTimes(j);
+            int total = 0;
+            for (int i = 0; i < numMachines; ++i) total += times[i];
+            bound += std::max(0, total - dueDates[j]);
+        }
+        objectiveLowerBound = static_cast<int>(std::min<long long>(bound, std::numeric_limits<int>::max()));
+    }
+}
+
+void Problem::setDueDates(const std::vector<int>& dates) {
+    if (dates.size() != static_cast<size_t>(numJobs)) {
+        throw std::invalid_argument("Expected " + std::to_string(numJobs) + " due dates");
+    }
+    dueDates = dates;
+    if (objective == Objective::Tardiness) {
+        setObjective(objective);  // Recomputes the bound
+    }
+}
+
+double Problem::relativeGap(int makespan) const {
+    int bound = getLowerBound();
+    return bound > 0 ? static_cast<double>(makespan - bound) / bound : 0.0;
+}
+
+int Problem::evaluate(const std::vector<int>& permutation) const {
+    if (permutation.size() != static_cast<size_t>(numJobs)) {
+        throw std::runtime_error("Invalid permutation size");
+    }
+    return evaluate(permutation.data());
+}
+
+int Problem::evaluate(const int* permutation) const {
+    return withObjective(objective, [&](auto policy) { return decltype(policy)::evaluate(*this, permutation); });
+}
+
+int Problem::evaluate(const int* permutation, int cutoff) const {
+    return withObjective(objective, [&](auto policy) {
+        return decltype(policy)::evaluate(*this, permutation, cutoff);
+    });
+}
+
+int Problem::calculateMakespan(const std::vector<int>& permutation) const {
+    if (permutation.size() != static_cast<size_t>(numJobs)) {
+        throw std::runtime_error("Invalid permutation size");
+    }
+    
+    return calculateMakespan(permutation.data());
+}
+
+int Problem::calculateMakespan(const int* permutation) const {
+    // Completion times of the last scheduled job on every machine; one row
+    // is enough since each job only depends on its predecessor
+    std::vector<int> completionTimes(numMachines, 0);
+    
+    for (int j = 0; j < numJobs; ++j) {
+        const int* times = getJobTimes(permutation[j]);
+        completionTimes[0] += times[0];
+        for (int i = 1; i < numMachines; ++i) {
+            completionTimes[i] = std::max(completionTimes[i], completionTimes[i-1]) + times[i];
+        }
+    }
+    
+    return completionTimes[numMachines-1];
+}
+
+int Problem::calculateMakespan(const int* permutation, int cutoff) const {
+    std::vector<int> completionTimes(numMachines, 0);
+    
+    // The last machine still has to process every remaining job after the
+    // current completion time, so C[m-1] + remaining work bounds the makespan
+    int remaining = lastMachineWork;
+    for (int j = 0; j < numJobs; ++j) {
+        const int* times = getJobTimes(permutation[j]);
+        completionTimes[0] += times[0];
+        for (int i = 1; i < numMachines; ++i) {
+            completionTimes[i] = std::max(completionTimes[i], completionTimes[i-1]) + times[i];
+        }
+        remaining -= times[numMachines - 1];
+        int bound = completionTimes[numMachines-1] + remaining;
+        if (bound >= cutoff) {
+            return bound;
         }
     }
     
-    return completionTimes[numMachines-1][numJobs-1];
-} 
\ No newline at end of file
+    return completionTimes[numMachines-1];
+}
+
+int Problem::criticalBlocks(const std::vector<int>& permutation, std::vector<Block>& blocks) const {
+    // Full completion time matrix, needed to trace the path back
+    std::vector<int> completion(static_cast<size_t>(numJobs) * numMachines);
+    for (int j = 0; j < numJobs; ++j) {
+        const int* times = getJobTimes(permutation[j]);
+        int* row = &completion[static_cast<size_t>(j) * numMachines];
+        const int* prev = j > 0 ? row - numMachines : nullptr;
+        for (int i = 0; i < numMachines; ++i) {
+            int ready = std::max(i > 0 ? row[i-1] : 0, prev ? prev[i] : 0);
+            row[i] = ready + times[i];
+        }
+    }
+    
+    // Walk back from the last operation, following whichever predecessor
+    // (previous job on the same machine, or same job on the previous
+    // machine) determined its start time
+    blocks.clear();
+    int j = numJobs - 1;
+    int i = numMachines - 1;
+    int blockLast = j;
+    while (j > 0 || i > 0) {
+        int sameMachine = j > 0 ? completion[static_cast<size_t>(j - 1) * numMachines + i] : -1;
+        int sameJob = i > 0 ? completion[static_cast<size_t>(j) * numMachines + i - 1] : -1;
+        if (sameMachine >= sameJob) {
+            --j;
+        } else {
+            blocks.push_back({j, blockLast, i});
+            --i;
+            blockLast = j;
+        }
+    }
+    blocks.push_back({0, blockLast, 0});
+    std::reverse(blocks.begin(), blocks.end());
+    
+    return completion.back();
+}
+
+const std::vector<int>& Problem::getCachedPermutation(const std::string& key,
+                                                      const std::function<std::vector<int>()>& compute) const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = permutationCache.find(key);
+    if (it == permutationCache.end()) {
+        it = permutationCache.emplace(key, compute()).first;
+    }
+    return it->second;
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "profiler.hpp"
+
+#ifdef PFSP_PROFILE
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Site {
+    std::string name;
+    bool counter;
+};
+
+// Shared state, behind one mutex: only registration, thread start and
+// exit, and report() take it
+struct Registry {
+    std::mutex mutex;
+    std::vector<Site> sites;
+    std::vector<void*> threads;              // Live ThreadTotals
+    std::vector<uint64_t> retiredTicks = std::vector<uint64_t>(Profiler::maxSites, 0);
+    std::vector<uint64_t> retiredCalls = std::vector<uint64_t>(Profiler::maxSites, 0);
+
+    // Reference points to convert clock ticks into seconds
+    uint64_t startTicks = Profiler::now();
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+// Clock ticks per second, measured against the steady clock since startup
+double ticksPerSecond() {
+    Registry& reg = registry();
+    auto elapsed = [&] {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - reg.startTime).count();
+    };
+    while (elapsed() < 0.01) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    double seconds = elapsed();
+    return static_cast<double>(Profiler::now() - reg.startTicks) / seconds;
+}
+
+} // namespace
+
+int Profiler::registerSite(const char* name, bool counter) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    auto it = std::find_if(reg.sites.begin(), reg.sites.end(), [&](const Site& site) { return site.name == name; });
+    if (it != reg.sites.end()) {
+        return static_cast<int>(it - reg.sites.begin());
+    }
+    if (static_cast<int>(reg.sites.size()) >= maxSites) {
+        return maxSites - 1;  // Out of slots, the last one collects the rest
+    }
+    reg.sites.push_back({name, counter});
+    return static_cast<int>(reg.sites.size()) - 1;
+}
+
+Profiler::ThreadTotals::ThreadTotals() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.threads.push_back(this);
+}
+
+Profiler::ThreadTotals::~ThreadTotals() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (int s = 0; s < maxSites; ++s) {
+        reg.retiredTicks[s] += sites[s].ticks.load(std::memory_order_relaxed);
+        reg.retiredCalls[s] += sites[s].calls.load(std::memory_order_relaxed);
+    }
+    reg.threads.erase(std::find(reg.threads.begin(), reg.threads.end(), this));
+}
+
+void Profiler::report(std::ostream& out) {
+    Registry& reg = registry();
+    double frequency = ticksPerSecond();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    struct Line {
+        const Site* site;
+        uint64_t ticks;
+        uint64_t calls;
+    };
+    std::vector<Line> lines;
+    for (size_t s = 0; s < reg.sites.size(); ++s) {
+        uint64_t ticks = reg.retiredTicks[s];
+        uint64_t calls = reg.retiredCalls[s];
+        reg.retiredTicks[s] = 0;
+        reg.retiredCalls[s] = 0;
+        for (void* thread : reg.threads) {
+            Totals& totals = static_cast<ThreadTotals*>(thread)->sites[s];
+            ticks += totals.ticks.exchange(0, std::memory_order_relaxed);
+            calls += totals.calls.exchange(0, std::memory_order_relaxed);
+        }
+        if (calls > 0) {
+            lines.push_back({&reg.sites[s], ticks, calls});
+        }
+    }
+    if (lines.empty()) {
+        return;
+    }
+
+    // Phases by decreasing total time, then the counters
+    std::sort(lines.begin(), lines.end(), [](const Line& a, const Line& b) {
+        if (a.site->counter != b.site->counter) {
+            return !a.site->counter;
+        }
+        return a.site->counter ? a.site->name < b.site->name : a.ticks > b.ticks;
+    });
+
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << "Profile (inclusive, all threads):" << std::endl;
+    out << "  " << std::left << std::setw(44) << "Phase" << std::right << std::setw(12) << "Calls"
+        << std::setw(14) << "Total ms" << std::setw(14) << "Per call us" << std::endl;
+    for (const Line& line : lines) {
+        out << "  " << std::left << std::setw(44) << line.site->name << std::right << std::setw(12) << line.calls;
+        if (!line.site->counter) {
+            double seconds = line.ticks / frequency;
+            out << std::fixed << std::setprecision(3) << std::setw(14) << 1e3 * seconds
+                << std::setw(14) << 1e6 * seconds / line.calls;
+        }
+        out << std::endl;
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+#endif
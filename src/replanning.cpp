@@ -0,0 +1,199 @@
+#include "replanning.hpp"
+#include "insertion_search.hpp"
+#include "profiler.hpp"
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+ChangedInstance applyJobChanges(const Problem& previous, const std::vector<JobChange>& changes) {
+    int n = previous.getNumJobs();
+    int m = previous.getNumMachines();
+
+    // Times of every job after the changes, by previous job number; added
+    // jobs are appended
+    std::vector<std::vector<int>> jobTimes(n);
+    std::vector<char> removed(n, 0);
+    std::vector<char> touched(n, 0);
+    for (int j = 0; j < n; ++j) {
+        jobTimes[j].assign(previous.getJobTimes(j), previous.getJobTimes(j) + m);
+    }
+
+    for (const JobChange& change : changes) {
+        if (change.type != JobChange::Type::Add &&
+            (change.job < 0 || change.job >= n || removed[change.job])) {
+            throw std::invalid_argument("No job " + std::to_string(change.job) + " to change");
+        }
+        if (change.type != JobChange::Type::Remove && change.times.size() != static_cast<size_t>(m)) {
+            throw std::invalid_argument("Expected " + std::to_string(m) + " processing times per job");
+        }
+        switch (change.type) {
+            case JobChange::Type::Add:
+                jobTimes.push_back(change.times);
+                removed.push_back(0);
+                touched.push_back(1);
+                break;
+            case JobChange::Type::Remove:
+                removed[change.job] = 1;
+                break;
+            case JobChange::Type::Update:
+                jobTimes[change.job] = change.times;
+                touched[change.job] = 1;
+                break;
+        }
+    }
+
+    ChangedInstance result;
+    result.previousNumJobs = n;
+    for (size_t j = 0; j < jobTimes.size(); ++j) {
+        if (removed[j]) {
+            continue;
+        }
+        if (touched[j]) {
+            result.touchedJobs.push_back(static_cast<int>(result.previousJob.size()));
+        }
+        result.previousJob.push_back(j < static_cast<size_t>(n) ? static_cast<int>(j) : -1);
+    }
+    if (result.previousJob.empty()) {
+        throw std::invalid_argument("No job left after the changes");
+    }
+
+    std::vector<std::vector<int>> processingTimes(m, std::vector<int>(result.previousJob.size()));
+    int job = 0;
+    for (size_t j = 0; j < jobTimes.size(); ++j) {
+        if (!removed[j]) {
+            for (int i = 0; i < m; ++i) {
+                processingTimes[i][job] = jobTimes[j][i];
+            }
+            ++job;
+        }
+    }
+    result.problem = std::make_unique<Problem>(processingTimes);
+    return result;
+}
+
+Solution repairSchedule(const ChangedInstance& instance, const std::vector<int>& previousPermutation) {
+    PFSP_PROFILE_SCOPE("repairSchedule");
+    const Problem& problem = *instance.problem;
+    int n = problem.getNumJobs();
+    int m = problem.getNumMachines();
+
+    // New number of every previous job, -1 if removed
+    int previousJobs = instance.previousNumJobs;
+    if (previousPermutation.size() != static_cast<size_t>(previousJobs)) {
+        throw std::invalid_argument("Previous schedule has " + std::to_string(previousPermutation.size()) +
+                                    " jobs, the previous instance " + std::to_string(previousJobs));
+    }
+    std::vector<int> newJob(previousJobs, -1);
+    for (int j = 0; j < n; ++j) {
+        int old = instance.previousJob[j];
+        if (old >= 0) {
+            newJob[old] = j;
+        }
+    }
+
+    std::vector<char> isTouched(n, 0);
+    for (int job : instance.touchedJobs) {
+        isTouched[job] = 1;
+    }
+    std::vector<char> seen(previousJobs, 0);
+    std::vector<int> sequence;
+    sequence.reserve(n);
+    for (int old : previousPermutation) {
+        if (old < 0 || old >= previousJobs || seen[old]) {
+            throw std::invalid_argument("Previous schedule is not a permutation");
+        }
+        seen[old] = 1;
+        if (newJob[old] >= 0 && !isTouched[newJob[old]]) {
+            sequence.push_back(newJob[old]);
+        }
+    }
+
+    // Reinsert the touched jobs NEH style, the longest first
+    std::vector<int> touched = instance.touchedJobs;
+    std::vector<long long> totals(n, 0);
+    for (int job : touched) {
+        const int* times = problem.getJobTimes(job);
+        totals[job] = std::accumulate(times, times + m, 0LL);
+    }
+    std::stable_sort(touched.begin(), touched.end(), [&](int a, int b) { return totals[a] > totals[b]; });
+
+    InsertionSearch insertion(problem);
+    int makespan = 0;
+    for (int job : touched) {
+        int position;
+        makespan = insertion.bestInsertion(sequence, job, position);
+        sequence.insert(sequence.begin() + position, job);
+    }
+    if (touched.empty()) {
+        makespan = problem.evaluate(sequence);
+    }
+
+    // Removing jobs can also open gaps worth closing, so the neighbors of
+    // removed jobs are looked at along with the touched ones
+    std::vector<int> around = touched;
+    for (size_t k = 0; k < previousPermutation.size(); ++k) {
+        if (newJob[previousPermutation[k]] >= 0) {
+            continue;
+        }
+        for (size_t near : {k - 1, k + 1}) {
+            if (near < previousPermutation.size() && newJob[previousPermutation[near]] >= 0) {
+                around.push_back(newJob[previousPermutation[near]]);
+            }
+        }
+    }
+    insertion.descendFrom(sequence, makespan, around);
+
+    Solution solution(problem);
+    solution.setPermutation(sequence, makespan);
+    return solution;
+}
+
+std::vector<JobChange> readJobChanges(std::istream& in) {
+    std::vector<JobChange> changes;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+        std::istringstream iss(line);
+        std::string type;
+        if (!(iss >> type)) {
+            continue;
+        }
+
+        JobChange change{JobChange::Type::Add, -1, {}};
+        if (type == "remove" || type == "update") {
+            change.type = type == "remove" ? JobChange::Type::Remove : JobChange::Type::Update;
+            if (!(iss >> change.job)) {
+                throw std::invalid_argument("Missing job number on line " + std::to_string(lineNumber));
+            }
+        } else if (type != "add") {
+            throw std::invalid_argument("Unknown change '" + type + "' on line " + std::to_string(lineNumber));
+        }
+        int time;
+        while (iss >> time) {
+            change.times.push_back(time);
+        }
+        if (!iss.eof()) {
+            throw std::invalid_argument("Invalid number on line " + std::to_string(lineNumber));
+        }
+        changes.push_back(change);
+    }
+    return changes;
+}
+
+void writeInstance(const Problem& problem, const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out.is_open()) {
+        throw std::runtime_error("Cannot write " + filename);
+    }
+    out << problem.getNumJobs() << " " << problem.getNumMachines() << "\n";
+    for (int i = 0; i < problem.getNumMachines(); ++i) {
+        for (int j = 0; j < problem.getNumJobs(); ++j) {
+            out << (j > 0 ? " " : "") << problem.getProcessingTime(i, j);
+        }
+        out << "\n";
+    }
+}
@@ -1,9 +1,10 @@
 #include "simulated_annealing.hpp"
-#include "constructive.hpp"
-#include <random>
+#include "zobrist.hpp"
+#include "profiler.hpp"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
+#include <limits>
 
 SimulatedAnnealing::SimulatedAnnealing(const Problem& problem) 
     : Metaheuristic(problem), 
@@ -11,8 +12,7 @@ SimulatedAnnealing::SimulatedAnnealing(const Problem& problem)
       initialTemperature(1000.0),
       coolingRate(0.95),
       temperature(initialTemperature), 
-      iterations(0), 
-      gen(rd()) {}
+      iterations(0) {}
 
 SimulatedAnnealing::SimulatedAnnealing(const Problem& problem, int maxIterations, 
                                       double initialTemperature, double coolingRate) 
@@ -21,53 +21,79 @@ SimulatedAnnealing::SimulatedAnnealing(const Problem& problem, int maxIterations
       initialTemperature(initialTemperature),
       coolingRate(coolingRate),
       temperature(initialTemperature), 
-      iterations(0), 
-      gen(rd()) {}
+      iterations(0) {}
 
-      Solution SimulatedAnnealing::solve() {
-        Constructive neh = Constructive(problem);
-        Solution initial_solution = neh.solve();
-        startTimer();
-    
-        bestSolution = initial_solution;
-    
-        Solution current = bestSolution;
-        iterations = 0;
-        temperature = initialTemperature;
-    
-        while (iterations < maxIterations) {
-            // Generate random neighbor
-            std::uniform_int_distribution<> dis(0, problem.getNumJobs() - 1);
-            int pos1 = dis(gen);
-            int pos2 = dis(gen);
-            if (pos1 != pos2) {
-                Solution neighbor = current;
-                neighbor.swap(pos1, pos2);
-    
-                // Accept if better or with probability
-                if (neighbor.getMakespan() < current.getMakespan() || 
-                    acceptWorseSolution(current.getMakespan(), neighbor.getMakespan())) {
-                    current = neighbor;
-    
-                    if (current.getMakespan() < bestSolution.getMakespan()) {
-                        bestSolution = current;
-                    }
-                }
+Solution SimulatedAnnealing::solve() {
+    Solution initial_solution = startingSolution();
+    startTimer();
+
+    updateBest(initial_solution);
+
+    Solution current = bestSolution;
+    current.setTranspositionTable(transpositionTable.get());
+    iterations = 0;
+    temperature = initialTemperature;
+
+    while (!iterationLimitReached(iterations, maxIterations) && !shouldStop()) {
+        // Generate random neighbor
+        int positions[2];
+        rng.fillBelow(problem.getNumJobs(), positions, 2);
+        int pos1 = positions[0];
+        int pos2 = positions[1];
+        if (pos1 != pos2) {
+            // The acceptance test is decided before evaluating, so the
+            // evaluation can stop once the neighbor is known to be rejected
+            double threshold = acceptanceThreshold(current.getMakespan());
+            int makespan = evaluateNeighbor(current, pos1, pos2, threshold);
+            countEvaluations();
+
+            if (makespan < threshold) {
+                current.setPermutation(neighbor, makespan);
+                updateBest(current);
             }
+        }
+
+        updateTemperature();
+        iterations++;
+    }
+
+    stopTimer();
+    return bestSolution;
+}
+
+double SimulatedAnnealing::acceptanceThreshold(int currentMakespan) {
+    // Metropolis: u < exp(-(new - current) / T)  <=>  new < current - T * ln(u).
+    // Improvements and sideways moves are always below the threshold.
+    double u = rng.uniform();
+    if (u <= 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return currentMakespan - temperature * std::log(u);
+}
+
+int SimulatedAnnealing::evaluateNeighbor(const Solution& current, int pos1, int pos2, double threshold) {
+    PFSP_PROFILE_SCOPE("SimulatedAnnealing::evaluateNeighbor");
+    neighbor = current.getPermutation();
+    std::swap(neighbor[pos1], neighbor[pos2]);
     
-            updateTemperature();
-            iterations++;
+    TranspositionTable* table = transpositionTable.get();
+    uint64_t hash = 0;
+    int makespan;
+    if (table) {
+        hash = zobristSwapHash(current.getPermutation(), current.getHash(), pos1, pos2);
+        if (table->lookup(hash, makespan)) {
+            return makespan;
         }
+    }
     
-        stopTimer();
-        return bestSolution;
+    // Any makespan >= cutoff is rejected, which an early abort also proves
+    double ceiling = std::ceil(threshold);
+    int cutoff = ceiling < std::numeric_limits<int>::max() ? static_cast<int>(ceiling) : std::numeric_limits<int>::max();
+    makespan = problem.evaluate(neighbor.data(), cutoff);
+    if (table && makespan < cutoff) {
+        table->store(hash, makespan);
     }
-
-bool SimulatedAnnealing::acceptWorseSolution(int currentMakespan, int newMakespan) {
-    std::uniform_real_distribution<> dis(0.0, 1.0);
-    double delta = newMakespan - currentMakespan;
-    double probability = std::exp(-delta / temperature);
-    return dis(gen) < probability;
+    return makespan;
 }
 
 void SimulatedAnnealing::updateTemperature() {
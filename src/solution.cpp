@@ -1,11 +1,13 @@
 #include "solution.hpp"
+#include "zobrist.hpp"
 #include <algorithm>
 #include <random>
 
-Solution::Solution(const Problem& problem) : problem(problem) {
+Solution::Solution(const Problem& problem) : problem(problem), transpositionTable(nullptr) {
     // Initialize with identity permutation
     permutation.resize(problem.getNumJobs());
     std::iota(permutation.begin(), permutation.end(), 0);
+    hash = hashPermutation(permutation);
     evaluate();
 }
 
@@ -13,7 +15,9 @@ Solution::Solution(const Problem& problem) : problem(problem) {
 Solution::Solution(const Solution& other) 
     : problem(other.problem), 
       permutation(other.permutation), 
-      makespan(other.makespan) {}
+      makespan(other.makespan), 
+      hash(other.hash), 
+      transpositionTable(other.transpositionTable) {}
 
 // Assignment operator
 Solution& Solution::operator=(const Solution& other) {
@@ -21,6 +25,8 @@ Solution& Solution::operator=(const Solution& other) {
         // Note: We can't change the problem reference after construction
         permutation = other.permutation;
         makespan = other.makespan;
+        hash = other.hash;
+        transpositionTable = other.transpositionTable;
     }
     return *this;
 }
@@ -52,15 +58,24 @@ void Solution::setPermutation(const std::vector<int>& newPermutation) {
     }
     
     permutation = newPermutation;
+    hash = hashPermutation(permutation);
     evaluate();
 }
 
+void Solution::setPermutation(const std::vector<int>& newPermutation, int knownMakespan) {
+    permutation = newPermutation;
+    hash = hashPermutation(permutation);
+    makespan = knownMakespan;
+}
+
 void Solution::swap(int i, int j) {
+    hash = zobristSwapHash(permutation, hash, i, j);
     std::swap(permutation[i], permutation[j]);
     evaluate();
 }
 
 void Solution::insert(int i, int j) {
+    hash = zobristInsertHash(permutation, hash, i, j);
     if (i < j) {
         int temp = permutation[i];
         for (int k = i; k < j; ++k) {
@@ -80,9 +95,16 @@ void Solution::insert(int i, int j) {
 void Solution::reverse(int i, int j) {
     if (i > j) std::swap(i, j);
     std::reverse(permutation.begin() + i, permutation.begin() + j + 1);
+    hash = hashPermutation(permutation);
     evaluate();
 }
 
 void Solution::evaluate() {
-    makespan = problem.calculateMakespan(permutation);
+    if (transpositionTable && transpositionTable->lookup(hash, makespan)) {
+        return;
+    }
+    makespan = problem.evaluate(permutation);
+    if (transpositionTable) {
+        transpositionTable->store(hash, makespan);
+    }
 } 
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "solver_factory.hpp"
+#include "constructive.hpp"
+#include "local_search.hpp"
+#include "iterated_local_search.hpp"
+#include "simulated_annealing.hpp"
+#include "tabu_search.hpp"
+#include "genetic_algorithm.hpp"
+#include "ant_colony.hpp"
+#include "iterated_greedy.hpp"
+#include "branch_and_bound.hpp"
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// Typed access to the parameters; every key must be read by the solver
+class ParamReader {
+public:
+    ParamReader(const std::string& solver, const SolverParams& params) : solver(solver), params(params) {}
+
+    int getInt(const std::string& key, int fallback) {
+        return get(key, fallback, [](const std::string& value, size_t& used) { return std::stoi(value, &used); });
+    }
+    long long getLong(const std::string& key, long long fallback) {
+        return get(key, fallback, [](const std::string& value, size_t& used) { return std::stoll(value, &used); });
+    }
+    double getDouble(const std::string& key, double fallback) {
+        return get(key, fallback, [](const std::string& value, size_t& used) { return std::stod(value, &used); });
+    }
+    std::string getString(const std::string& key, const std::string& fallback) {
+        read.insert(key);
+        auto it = params.find(key);
+        return it == params.end() ? fallback : it->second;
+    }
+
+    void checkAllRead() const {
+        for (const auto& [key, value] : params) {
+            if (read.find(key) == read.end()) {
+                throw std::invalid_argument("Unknown parameter for " + solver + ": " + key);
+            }
+        }
+    }
+
+private:
+    template <typename T, typename Parse>
+    T get(const std::string& key, T fallback, Parse parse) {
+        read.insert(key);
+        auto it = params.find(key);
+        if (it == params.end()) {
+            return fallback;
+        }
+        try {
+            size_t used = 0;
+            T value = parse(it->second, used);
+            if (used == it->second.size()) {
+                return value;
+            }
+        } catch (const std::exception&) {
+        }
+        throw std::invalid_argument("Invalid value for " + solver + " parameter " + key + ": " + it->second);
+    }
+
+    const std::string& solver;
+    const SolverParams& params;
+    std::set<std::string> read;
+};
+
+} // namespace
+
+std::unique_ptr<Metaheuristic> createSolver(const std::string& name, const Problem& problem,
+                                            const SolverParams& params) {
+    ParamReader reader(name, params);
+    std::unique_ptr<Metaheuristic> solver;
+
+    if (name == "neh") {
+        solver = std::make_unique<Constructive>(problem);
+    } else if (name == "ls") {
+        solver = std::make_unique<LocalSearch>(problem, reader.getInt("iter", 1000));
+    } else if (name == "ils") {
+        solver = std::make_unique<IteratedLocalSearch>(problem, reader.getInt("iter", 100), reader.getInt("perturb", 3));
+    } else if (name == "sa") {
+        solver = std::make_unique<SimulatedAnnealing>(problem, reader.getInt("iter", 1000),
+                                                      reader.getDouble("temp", 1000.0), reader.getDouble("cool", 0.95));
+    } else if (name == "ts") {
+        auto ts = std::make_unique<TabuSearch>(problem, reader.getInt("iter", 1000), reader.getInt("tabu", 10));
+        std::string neighborhood = reader.getString("neighborhood", "blocks");
+        if (neighborhood != "blocks" && neighborhood != "swap") {
+            throw std::invalid_argument("Invalid Tabu Search neighborhood: " + neighborhood);
+        }
+        ts->setNeighborhood(neighborhood == "swap" ? TabuSearch::Neighborhood::Swap
+                                                   : TabuSearch::Neighborhood::CriticalBlocks);
+        solver = std::move(ts);
+    } else if (name == "ga") {
+        auto ga = std::make_unique<GeneticAlgorithm>(problem, reader.getInt("pop", 50), reader.getInt("gen", 100),
+                                                     reader.getDouble("mut", 0.1));
+        ga->setSteadyState(reader.getInt("steady", 0) != 0);
+        solver = std::move(ga);
+    } else if (name == "aco") {
+        auto aco = std::make_unique<AntColony>(problem, reader.getInt("ants", 20), reader.getInt("iter", 100),
+                                               reader.getDouble("evap", 0.1), reader.getDouble("alpha", 1.0),
+                                               reader.getDouble("beta", 2.0));
+        AntColony::PheromoneOptions options;
+        std::string model = reader.getString("model", "succession");
+        if (model != "succession" && model != "position") {
+            throw std::invalid_argument("Invalid pheromone model: " + model);
+        }
+        options.model = model == "position" ? AntColony::PheromoneModel::JobPosition
+                                            : AntColony::PheromoneModel::JobSuccession;
+        options.singlePrecision = reader.getInt("float", 0) != 0;
+        aco->setPheromoneOptions(options);
+        solver = std::move(aco);
+    } else if (name == "ig") {
+        solver = std::make_unique<IteratedGreedy>(problem, reader.getInt("iter", 500), reader.getInt("d", 4),
+                                                  reader.getDouble("temp", 0.4));
+    } else if (name == "bnb") {
+        solver = std::make_unique<BranchAndBound>(problem, reader.getInt("threads", 0),
+                                                  reader.getLong("nodes", 100000000));
+    } else {
+        throw std::invalid_argument("Unknown solver: " + name);
+    }
+
+    reader.checkAllRead();
+    return solver;
+}
+
+SolverParams parseSolverParams(const std::string& text) {
+    SolverParams params;
+    std::istringstream iss(text);
+    std::string token;
+    while (std::getline(iss, token, ',')) {
+        if (token.empty()) {
+            continue;
+        }
+        size_t equals = token.find('=');
+        if (equals == std::string::npos || equals == 0) {
+            throw std::invalid_argument("Expected key=value, got: " + token);
+        }
+        params[token.substr(0, equals)] = token.substr(equals + 1);
+    }
+    return params;
+}
+
+const std::vector<std::string>& solverNames() {
+    static const std::vector<std::string> names = {"neh", "ls", "ils", "sa", "ts", "ga", "aco", "ig", "bnb"};
+    return names;
+}
@@ -0,0 +1,479 @@
+#include "solver_server.hpp"
+#include "solver_factory.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#define PFSP_HAS_UNIX_SOCKETS 1
+#endif
+
+// Replies go through send, one line at a time; requests still queued or
+// running are counted so the session can end only after their replies
+struct SolverServer::Session {
+    std::function<void(const std::string&)> send;
+    std::mutex writeMutex;
+
+    std::mutex mutex;
+    std::condition_variable idle;
+    int pending = 0;
+    long long nextId = 1;
+    std::map<std::string, CancellationToken> active;  // By request id
+
+    void reply(const std::string& line) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        send(line);
+    }
+};
+
+namespace {
+
+using Fields = std::map<std::string, std::string>;
+
+// Error messages end the reply line, so they may hold spaces but no newlines
+std::string errorReply(const std::string& id, const std::string& message) {
+    std::string text = message;
+    std::replace(text.begin(), text.end(), '\n', ' ');
+    std::replace(text.begin(), text.end(), '\r', ' ');
+    return (id.empty() ? "" : "id=" + id + " ") + "status=error message=" + text;
+}
+
+std::string take(Fields& fields, const std::string& key, const std::string& fallback = "") {
+    auto it = fields.find(key);
+    if (it == fields.end()) {
+        return fallback;
+    }
+    std::string value = it->second;
+    fields.erase(it);
+    return value;
+}
+
+template <typename T, typename Parse>
+T parseNumber(const std::string& key, const std::string& value, Parse parse) {
+    try {
+        size_t used = 0;
+        T result = parse(value, &used);
+        if (used == value.size()) {
+            return result;
+        }
+    } catch (const std::exception&) {
+    }
+    throw std::invalid_argument("Invalid value for " + key + ": " + value);
+}
+
+double takeDouble(Fields& fields, const std::string& key, double fallback) {
+    std::string value = take(fields, key);
+    return value.empty() ? fallback : parseNumber<double>(key, value, [](const std::string& s, size_t* used) {
+        return std::stod(s, used);
+    });
+}
+
+long long takeLong(Fields& fields, const std::string& key, long long fallback) {
+    std::string value = take(fields, key);
+    return value.empty() ? fallback : parseNumber<long long>(key, value, [](const std::string& s, size_t* used) {
+        return std::stoll(s, used);
+    });
+}
+
+void checkEmpty(const Fields& fields) {
+    if (!fields.empty()) {
+        throw std::invalid_argument("Unknown field: " + fields.begin()->first);
+    }
+}
+
+} // namespace
+
+SolverServer::SolverServer(int numThreads)
+    : stopping(false), openConnections(0), requestCount(0), running(0), shutdownRequested(false) {
+    int count = numThreads > 0 ? numThreads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int t = 0; t < count; ++t) {
+        workers.emplace_back(&SolverServer::work, this);
+    }
+}
+
+SolverServer::~SolverServer() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueReady.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void SolverServer::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back(std::move(task));
+    }
+    queueReady.notify_one();
+}
+
+void SolverServer::work() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (queue.empty()) {
+                return;
+            }
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        task();
+    }
+}
+
+void SolverServer::serve(std::istream& in, std::ostream& out) {
+    auto session = std::make_shared<Session>();
+    session->send = [&out](const std::string& line) { out << line << std::endl; };
+
+    std::string line;
+    while (!shutdownRequested && std::getline(in, line)) {
+        handle(session, line);
+    }
+
+    std::unique_lock<std::mutex> lock(session->mutex);
+    session->idle.wait(lock, [&] { return session->pending == 0; });
+}
+
+void SolverServer::handle(const std::shared_ptr<Session>& session, const std::string& line) {
+    std::istringstream iss(line);
+    std::string command;
+    if (!(iss >> command)) {
+        return;  // Blank line
+    }
+
+    Fields fields;
+    std::string token;
+    while (iss >> token) {
+        size_t equals = token.find('=');
+        if (equals == std::string::npos || equals == 0) {
+            session->reply(errorReply("", "Expected key=value, got: " + token));
+            return;
+        }
+        fields[token.substr(0, equals)] = token.substr(equals + 1);
+    }
+
+    std::string id = fields.count("id") ? fields["id"] : "";
+    try {
+        if (command == "solve") {
+            solve(session, std::move(fields));
+        } else if (command == "load") {
+            load(session, std::move(fields));
+        } else if (command == "cancel") {
+            take(fields, "id");
+            checkEmpty(fields);
+            std::lock_guard<std::mutex> lock(session->mutex);
+            auto it = session->active.find(id);
+            if (it == session->active.end()) {
+                throw std::invalid_argument("No running request with this id");
+            }
+            it->second.cancel();
+            session->reply("id=" + id + " status=cancelling");
+        } else if (command == "stats") {
+            checkEmpty(fields);
+            size_t numInstances;
+            {
+                std::lock_guard<std::mutex> lock(instanceMutex);
+                numInstances = instances.size();
+            }
+            size_t queued;
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                queued = queue.size();
+            }
+            session->reply("status=stats instances=" + std::to_string(numInstances) +
+                           " requests=" + std::to_string(requestCount.load()) +
+                           " running=" + std::to_string(running.load()) +
+                           " queued=" + std::to_string(queued) +
+                           " threads=" + std::to_string(getNumThreads()));
+        } else if (command == "shutdown") {
+            checkEmpty(fields);
+            shutdownRequested = true;
+            session->reply("status=shutdown");
+        } else {
+            throw std::invalid_argument("Unknown command: " + command);
+        }
+    } catch (const std::exception& e) {
+        session->reply(errorReply(id, e.what()));
+    }
+}
+
+void SolverServer::solve(const std::shared_ptr<Session>& session, Fields fields) {
+    std::string id = take(fields, "id");
+    std::string instance = take(fields, "instance");
+    std::string solverName = take(fields, "solver", "ig");
+    SolverParams params = parseSolverParams(take(fields, "params"));
+
+    Termination termination;
+    termination.timeLimit = takeDouble(fields, "time-limit", 0.0);
+    termination.maxEvaluations = takeLong(fields, "max-evals", 0);
+    termination.ignoreIterationLimits = takeLong(fields, "ignore-iter-limits", 0) != 0;
+    bool progress = takeLong(fields, "progress", 0) != 0;
+    std::string seedText = take(fields, "seed");
+    uint64_t seed = seedText.empty() ? Rng::randomSeed()
+                                     : parseNumber<unsigned long long>("seed", seedText,
+                                           [](const std::string& s, size_t* used) { return std::stoull(s, used); });
+    checkEmpty(fields);
+
+    if (instance.empty()) {
+        throw std::invalid_argument("Missing instance");
+    }
+    if (std::find(solverNames().begin(), solverNames().end(), solverName) == solverNames().end()) {
+        throw std::invalid_argument("Unknown solver: " + solverName);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        if (id.empty()) {
+            id = std::to_string(session->nextId++);
+        }
+        if (session->active.count(id)) {
+            throw std::invalid_argument("A request with this id is still running");
+        }
+        session->active[id] = termination.cancellation;
+        ++session->pending;
+    }
+    ++requestCount;
+
+    submit([this, session, id, instance, solverName, params, termination, progress, seed] {
+        ++running;
+        try {
+            std::shared_ptr<const Problem> problem = findInstance(instance);
+            std::unique_ptr<Metaheuristic> solver = createSolver(solverName, *problem, params);
+            solver->setTermination(termination);
+            solver->setSeed(seed);
+            if (progress) {
+                solver->setIncumbentCallback([&session, &id](const Solution& incumbent, double elapsed, long long evals) {
+                    std::ostringstream oss;
+                    oss << "id=" << id << " status=improved makespan=" << incumbent.getMakespan()
+                        << " time=" << std::fixed << std::setprecision(6) << elapsed << " evaluations=" << evals;
+                    session->reply(oss.str());
+                });
+            }
+
+            Solution best = solver->solve();
+            std::ostringstream oss;
+            bool cancelled = termination.cancellation.isCancelled();  // The incumbent when it stopped
+            oss << "id=" << id << " status=" << (cancelled ? "cancelled" : "done") << " makespan=" << best.getMakespan()
+                << " lower_bound=" << problem->getLowerBound() << std::fixed << std::setprecision(6)
+                << " time=" << solver->getExecutionTime() << " setup_time=" << solver->getSetupTime()
+                << " evaluations=" << solver->getEvaluations() << " seed=" << solver->getSeed() << " permutation=";
+            const std::vector<int>& perm = best.getPermutation();
+            for (size_t i = 0; i < perm.size(); ++i) {
+                oss << (i > 0 ? "," : "") << perm[i];
+            }
+            session->reply(oss.str());
+        } catch (const std::exception& e) {
+            session->reply(errorReply(id, e.what()));
+        }
+        --running;
+
+        {
+            std::lock_guard<std::mutex> lock(session->mutex);
+            session->active.erase(id);
+        }
+        finish(session);
+    });
+}
+
+void SolverServer::load(const std::shared_ptr<Session>& session, Fields fields) {
+    take(fields, "id");
+    std::string name = take(fields, "name");
+    std::string file = take(fields, "file");
+    if (name.empty()) {
+        throw std::invalid_argument("Missing name");
+    }
+
+    std::shared_ptr<const Problem> problem;
+    if (!file.empty()) {
+        checkEmpty(fields);
+        problem = std::make_shared<const Problem>(file);
+    } else {
+        long long jobs = takeLong(fields, "jobs", 0);
+        long long machines = takeLong(fields, "machines", 0);
+        std::string times = take(fields, "times");
+        checkEmpty(fields);
+        if (jobs <= 0 || machines <= 0) {
+            throw std::invalid_argument("Expected file or positive jobs and machines");
+        }
+
+        // Machine by machine, as in instance files
+        std::vector<std::vector<int>> processingTimes(machines, std::vector<int>(jobs));
+        std::istringstream iss(times);
+        std::string value;
+        long long count = 0;
+        while (std::getline(iss, value, ',')) {
+            if (count >= jobs * machines) {
+                throw std::invalid_argument("Too many processing times");
+            }
+            processingTimes[count / jobs][count % jobs] = static_cast<int>(
+                parseNumber<long long>("times", value, [](const std::string& s, size_t* used) { return std::stoll(s, used); }));
+            ++count;
+        }
+        if (count != jobs * machines) {
+            throw std::invalid_argument("Expected jobs * machines processing times");
+        }
+        problem = std::make_shared<const Problem>(processingTimes);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(instanceMutex);
+        instances[name] = problem;
+    }
+    session->reply("status=loaded name=" + name + " jobs=" + std::to_string(problem->getNumJobs()) +
+                   " machines=" + std::to_string(problem->getNumMachines()) +
+                   " lower_bound=" + std::to_string(problem->getLowerBound()));
+}
+
+std::shared_ptr<const Problem> SolverServer::findInstance(const std::string& name) {
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    auto it = instances.find(name);
+    if (it != instances.end()) {
+        return it->second;
+    }
+    // Not loaded by name: a file, kept under its path
+    auto problem = std::make_shared<const Problem>(name);
+    instances[name] = problem;
+    return problem;
+}
+
+void SolverServer::finish(const std::shared_ptr<Session>& session) {
+    std::lock_guard<std::mutex> lock(session->mutex);
+    if (--session->pending == 0) {
+        session->idle.notify_all();
+    }
+}
+
+#ifdef PFSP_HAS_UNIX_SOCKETS
+
+namespace {
+
+void sendAll(int fd, const std::string& data) {
+#ifdef MSG_NOSIGNAL
+    const int flags = MSG_NOSIGNAL;  // A closed connection must not kill the server
+#else
+    const int flags = 0;
+#endif
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t count = ::send(fd, data.data() + sent, data.size() - sent, flags);
+        if (count <= 0) {
+            return;  // Client gone; the replies are dropped
+        }
+        sent += static_cast<size_t>(count);
+    }
+}
+
+} // namespace
+
+void SolverServer::serveSocket(const std::string& path) {
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + path);
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        throw std::runtime_error("Cannot create socket: " + std::string(std::strerror(errno)));
+    }
+    ::unlink(path.c_str());
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(listener, 64) < 0) {
+        std::string error = std::strerror(errno);
+        ::close(listener);
+        throw std::runtime_error("Cannot listen on " + path + ": " + error);
+    }
+
+    while (!shutdownRequested) {
+        // Wakes up periodically to notice a shutdown request
+        pollfd waiting{listener, POLLIN, 0};
+        if (::poll(&waiting, 1, 200) <= 0) {
+            continue;
+        }
+        int fd = ::accept(listener, nullptr, nullptr);
+        if (fd < 0) {
+            continue;
+        }
+
+        // Detached so that a finished connection frees its thread at once;
+        // the count lets shutdown wait for the ones still open
+        {
+            std::lock_guard<std::mutex> lock(connectionMutex);
+            ++openConnections;
+        }
+        try {
+            std::thread(&SolverServer::serveConnection, this, fd).detach();
+        } catch (const std::system_error& e) {
+            std::cerr << "Cannot serve a connection: " << e.what() << std::endl;
+            closeConnection(fd);
+        }
+    }
+
+    ::close(listener);
+    ::unlink(path.c_str());
+    std::unique_lock<std::mutex> lock(connectionMutex);
+    connectionsClosed.wait(lock, [this] { return openConnections == 0; });
+}
+
+void SolverServer::serveConnection(int fd) {
+    auto session = std::make_shared<Session>();
+    session->send = [fd](const std::string& line) { sendAll(fd, line + "\n"); };
+
+    std::string buffer;
+    char chunk[4096];
+    ssize_t count;
+    while ((count = ::recv(fd, chunk, sizeof(chunk), 0)) > 0) {
+        buffer.append(chunk, static_cast<size_t>(count));
+        size_t newline;
+        while ((newline = buffer.find('\n')) != std::string::npos) {
+            std::string line = buffer.substr(0, newline);
+            buffer.erase(0, newline + 1);
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            handle(session, line);
+        }
+    }
+    if (!buffer.empty()) {
+        handle(session, buffer);
+    }
+
+    // The client may close its side after the last request and still read
+    // the replies
+    {
+        std::unique_lock<std::mutex> lock(session->mutex);
+        session->idle.wait(lock, [&] { return session->pending == 0; });
+    }
+    closeConnection(fd);
+}
+
+void SolverServer::closeConnection(int fd) {
+    ::close(fd);
+    std::lock_guard<std::mutex> lock(connectionMutex);
+    if (--openConnections == 0) {
+        connectionsClosed.notify_all();
+    }
+}
+
+#else
+
+void SolverServer::serveSocket(const std::string& path) {
+    throw std::runtime_error("Unix sockets are not available on this platform (" + path + "), use --serve");
+}
+
+#endif
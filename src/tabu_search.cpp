@@ -1,75 +1,171 @@
 #include "tabu_search.hpp"
-#include "constructive.hpp"
+#include "zobrist.hpp"
+#include "profiler.hpp"
 #include <random>
 #include <algorithm>
 #include <numeric>
+#include <limits>
 
 TabuSearch::TabuSearch(const Problem& problem) 
-    : Metaheuristic(problem), maxIterations(1000), tabuListSize(10) {}
+    : Metaheuristic(problem), maxIterations(1000), tabuListSize(10),
+      neighborhood(Neighborhood::CriticalBlocks), iteration(0), insertion(problem) {}
 
 TabuSearch::TabuSearch(const Problem& problem, int maxIterations, int tabuListSize) 
-    : Metaheuristic(problem), maxIterations(maxIterations), tabuListSize(tabuListSize) {}
+    : Metaheuristic(problem), maxIterations(maxIterations), tabuListSize(tabuListSize),
+      neighborhood(Neighborhood::CriticalBlocks), iteration(0), insertion(problem) {}
 
-    Solution TabuSearch::solve() {
-        Constructive neh = Constructive(problem);
-        Solution initial_solution = neh.solve();
-        startTimer();
-    
-        bestSolution = initial_solution;
-    
-        Solution current = bestSolution;
-        int iterations = 0;
-    
-        while (iterations < maxIterations) {
-            auto [i, j] = findBestNeighbor();
+Solution TabuSearch::solve() {
+    Solution initial_solution = startingSolution();
+    startTimer();
+
+    updateBest(initial_solution);
+
+    Solution current = bestSolution;
+    current.setTranspositionTable(transpositionTable.get());
+    int n = problem.getNumJobs();
+    tabuUntil.assign(static_cast<size_t>(n) * n, 0);
+    iteration = 0;
+
+    // Critical blocks only say something about the makespan
+    bool blockMoves = neighborhood == Neighborhood::CriticalBlocks && problem.getObjective() == Objective::Makespan;
+    while (!iterationLimitReached(iteration, maxIterations) && !shouldStop()) {
+        if (blockMoves) {
+            Move move = findBestBlockMove(current);
+            if (move.from != -1) {
+                updateTabuList(current.getPermutation(), move);
+                int job = current.getPermutation()[move.from];
+                removed = current.getPermutation();
+                removed.erase(removed.begin() + move.from);
+                removed.insert(removed.begin() + move.to, job);
+                current.setPermutation(removed, move.makespan);
+                updateBest(current);
+            }
+        } else {
+            auto [i, j] = findBestNeighbor(current);
             if (i != -1 && j != -1) {
+                updateTabuList(current.getPermutation(), i, j);
                 current.swap(i, j);
-                updateTabuList(i, j);
-    
-                if (current.getMakespan() < bestSolution.getMakespan()) {
-                    bestSolution = current;
-                }
+                updateBest(current);
             }
-            iterations++;
         }
-    
-        stopTimer();
-        return bestSolution;
+        iteration++;
     }
 
-bool TabuSearch::isTabu(int i, int j) const {
-    auto pair1 = std::make_pair(i, j);
-    auto pair2 = std::make_pair(j, i);
-    return std::find(tabuList.begin(), tabuList.end(), pair1) != tabuList.end() ||
-           std::find(tabuList.begin(), tabuList.end(), pair2) != tabuList.end();
+    stopTimer();
+    return bestSolution;
+}
+
+bool TabuSearch::isTabu(const std::vector<int>& permutation, int i, int j) const {
+    // Swapping positions i and j is tabu if either job would go back to a
+    // position it recently left
+    int n = problem.getNumJobs();
+    return tabuUntil[permutation[i] * n + j] > iteration ||
+           tabuUntil[permutation[j] * n + i] > iteration;
+}
+
+void TabuSearch::updateTabuList(const std::vector<int>& permutation, int i, int j) {
+    // Forbid both jobs from returning to the positions they are leaving
+    int n = problem.getNumJobs();
+    tabuUntil[permutation[i] * n + i] = iteration + tabuListSize;
+    tabuUntil[permutation[j] * n + j] = iteration + tabuListSize;
 }
 
-void TabuSearch::updateTabuList(int i, int j) {
-    tabuList.push_back({i, j});
-    if (tabuList.size() > tabuListSize) {
-        tabuList.pop_front();
+void TabuSearch::updateTabuList(const std::vector<int>& permutation, const Move& move) {
+    // An insertion shifts every job between the two positions by one, and
+    // each of them is forbidden from returning to its old position.
+    // Restricting only the moved job lets the shifted neighbor undo the
+    // move right away.
+    int n = problem.getNumJobs();
+    int first = std::min(move.from, move.to);
+    int last = std::max(move.from, move.to);
+    for (int pos = first; pos <= last; ++pos) {
+        tabuUntil[permutation[pos] * n + pos] = iteration + tabuListSize;
     }
 }
 
-std::pair<int, int> TabuSearch::findBestNeighbor() {
+std::pair<int, int> TabuSearch::findBestNeighbor(const Solution& current) {
+    PFSP_PROFILE_SCOPE("TabuSearch::findBestNeighbor");
     int bestI = -1, bestJ = -1;
     int bestMakespan = std::numeric_limits<int>::max();
     int n = problem.getNumJobs();
+    std::vector<int> neighbor = current.getPermutation();
+    TranspositionTable* table = transpositionTable.get();
     
     for (int i = 0; i < n - 1; ++i) {
         for (int j = i + 1; j < n; ++j) {
-            if (!isTabu(i, j)) {
-                Solution neighbor = bestSolution;
-                neighbor.swap(i, j);
-                
-                if (neighbor.getMakespan() < bestMakespan) {
-                    bestMakespan = neighbor.getMakespan();
-                    bestI = i;
-                    bestJ = j;
+            // The neighbor's hash follows from the current one in O(1), so
+            // revisited permutations skip the makespan computation
+            int makespan;
+            uint64_t hash = table ? zobristSwapHash(neighbor, current.getHash(), i, j) : 0;
+            if (!table || !table->lookup(hash, makespan)) {
+                std::swap(neighbor[i], neighbor[j]);
+                makespan = problem.evaluate(neighbor);
+                std::swap(neighbor[i], neighbor[j]);
+                if (table) {
+                    table->store(hash, makespan);
                 }
             }
+            countEvaluations();
+            
+            // Aspiration: a tabu move is allowed if it beats the best solution
+            bool allowed = !isTabu(neighbor, i, j) || makespan < bestSolution.getMakespan();
+            if (allowed && makespan < bestMakespan) {
+                bestMakespan = makespan;
+                bestI = i;
+                bestJ = j;
+            }
+            if (shouldStop()) {
+                return {bestI, bestJ};
+            }
         }
     }
     
     return {bestI, bestJ};
-} 
\ No newline at end of file
+}
+
+TabuSearch::Move TabuSearch::findBestBlockMove(const Solution& current) {
+    PFSP_PROFILE_SCOPE("TabuSearch::findBestBlockMove");
+    Move best{-1, -1, std::numeric_limits<int>::max()};
+    const std::vector<int>& permutation = current.getPermutation();
+    int n = problem.getNumJobs();
+    
+    // Every job of a block may move to the first or last position of that
+    // block. Jobs at a block boundary belong to two blocks.
+    problem.criticalBlocks(permutation, blocks);
+    candidates.clear();
+    for (const auto& block : blocks) {
+        for (int x = block.first; x <= block.last; ++x) {
+            if (x != block.first) candidates.push_back({x, block.first});
+            if (x != block.last) candidates.push_back({x, block.last});
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    PFSP_PROFILE_COUNT("TabuSearch::blockMoves", candidates.size());
+    
+    // One accelerated insertion pass per moved job covers all its targets
+    for (size_t c = 0; c < candidates.size();) {
+        int from = candidates[c].first;
+        int job = permutation[from];
+        removed.assign(permutation.begin(), permutation.begin() + from);
+        removed.insert(removed.end(), permutation.begin() + from + 1, permutation.end());
+        insertion.insertionValues(removed, job, makespans);
+        
+        for (; c < candidates.size() && candidates[c].first == from; ++c) {
+            int to = candidates[c].second;
+            int makespan = makespans[to];
+            countEvaluations();
+            
+            // Aspiration: a tabu move is allowed if it beats the best solution
+            bool allowed = tabuUntil[job * n + to] <= iteration || makespan < bestSolution.getMakespan();
+            if (allowed && makespan < best.makespan) {
+                best = {from, to, makespan};
+            }
+        }
+        if (shouldStop()) {
+            break;
+        }
+    }
+    
+    return best;
+}
@@ -0,0 +1,49 @@
+#include "transposition_table.hpp"
+
+TranspositionTable::TranspositionTable(size_t capacity) : probes(0), hits(0) {
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    slots.reset(new Slot[size]);
+    mask = size - 1;
+}
+
+bool TranspositionTable::lookup(uint64_t hash, int& makespan) const {
+    probes.fetch_add(1, std::memory_order_relaxed);
+    const Slot& slot = slots[hash & mask];
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    uint64_t check = slot.check.load(std::memory_order_relaxed);
+    
+    // An empty slot holds data 0, which no stored makespan uses
+    if (data == 0 || (check ^ data) != hash) {
+        return false;
+    }
+    hits.fetch_add(1, std::memory_order_relaxed);
+    makespan = static_cast<int>(data);
+    return true;
+}
+
+void TranspositionTable::store(uint64_t hash, int makespan) {
+    if (makespan <= 0) {
+        return;
+    }
+    Slot& slot = slots[hash & mask];
+    uint64_t data = static_cast<uint64_t>(makespan);
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.check.store(hash ^ data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i <= mask; ++i) {
+        slots[i].data.store(0, std::memory_order_relaxed);
+        slots[i].check.store(0, std::memory_order_relaxed);
+    }
+    probes.store(0, std::memory_order_relaxed);
+    hits.store(0, std::memory_order_relaxed);
+}
+
+double TranspositionTable::getHitRate() const {
+    long long total = getProbes();
+    return total > 0 ? static_cast<double>(getHits()) / total : 0.0;
+}